@@ -0,0 +1,55 @@
+/******************************************************************************/
+//	Cycle.h
+/******************************************************************************/
+#ifndef	CycleIncluded
+#define CycleIncluded
+/******************************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+
+#include	"Generic.h"
+
+#if	defined(CYCLE_SOURCE)
+#elif	defined(__x86_64__) || defined(__i386__)
+#include	<x86intrin.h>
+#else
+#error	"Cycle.h: define CYCLE_SOURCE, the cycle counter of this target"
+#endif
+
+/******************************************************************************/
+//	macros
+/******************************************************************************/
+
+//	CYCLE_SOURCE names a target provided u64 function reading the core cycle
+//	counter (e.g. DWT CYCCNT on Cortex-M); it replaces the x86 time stamp
+//	counter below and is required on every other target. The ISR reads it,
+//	so it must be a register read, not a system call
+#if	defined(CYCLE_SOURCE)
+u64		CYCLE_SOURCE	(void);
+#endif
+
+/******************************************************************************/
+//	service functions
+/******************************************************************************/
+
+/******************************************************************************/
+//	free running cycle counter
+/*
+	- CYCLE_SOURCE if defined, else the time stamp counter on x86
+*/
+static	inline	u64		CycleNow	(void)
+{
+#if	defined(CYCLE_SOURCE)
+	return	CYCLE_SOURCE();
+#elif	defined(__x86_64__) || defined(__i386__)
+	return	(u64)__rdtsc();
+#endif
+}
+
+/******************************************************************************/
+#endif  //  CycleIncluded
+/******************************************************************************/
+//  end of Cycle.h
+/******************************************************************************/
@@ -0,0 +1,176 @@
+/******************************************************************************/
+//	DualPot.hpp
+/******************************************************************************/
+
+#ifndef MOTIV_DUALPOT_HPP
+#define MOTIV_DUALPOT_HPP
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include <cstddef>
+#include <utility>
+
+extern "C" {
+#include "DualPot_Drv.h"
+}
+
+/* Generic.h defines bool as u8 for C; the prototypes above keep that, the
+ * C++ below uses the keyword */
+#undef bool
+
+/******************************************************************************/
+//	types
+/*
+	- header-only C++ front end of the C driver; the channel count is the
+	  template parameter, the pin wiring and step rate are the C driver's,
+	  so range limits, taps of constant setpoints, port masks and tick
+	  counts are computed by the compiler
+	- per-channel operations are unrolled for the exact channel count
+	- all members are static, the C driver is the one instance
+*/
+/******************************************************************************/
+namespace motiv {
+
+/* pins of one channel; bit n of the GPIO port drives PinT n */
+struct DualPotPins {
+    PinT Cs;                        /* chip select, low while the channel moves */
+    PinT Ud;                        /* up/down, high steps up */
+    PinT Inc;                       /* falling edge steps the wiper */
+};
+
+/* wiring of the C driver (pinCS/pinUD/pinINC in DualPot_Max5389.c) */
+struct DualPotWiring {
+    static constexpr DualPotPins Ch[DUALPOT_CH_QUAN] = {
+        {PinCSA, PinUDA, PinINCA},
+        {PinCSB, PinUDB, PinINCB}
+    };
+};
+
+/* request for one channel, built by DualPot<>::At */
+struct DualPotSetpoint {
+    u8 Channel;                     /* chA/chB, 0 if the request failed the range check */
+    u8 Tap;                         /* DUALPOT_TAP of the resistance */
+    u32 CsMask;                     /* port bits of the channel's pins */
+    u32 UdMask;
+    u32 IncMask;
+};
+
+namespace detail {
+
+/* port bits of channel index I; Pins: 1 CS, 2 U/D, 4 INC */
+constexpr u32 dualPotMask(std::size_t I, u32 Pins) {
+    return ((0U != (Pins & 1U)) ? (1UL << DualPotWiring::Ch[I].Cs) : 0UL) |
+           ((0U != (Pins & 2U)) ? (1UL << DualPotWiring::Ch[I].Ud) : 0UL) |
+           ((0U != (Pins & 4U)) ? (1UL << DualPotWiring::Ch[I].Inc) : 0UL);
+}
+
+template <std::size_t... I>
+constexpr u32 dualPotMaskAll(std::index_sequence<I...>, u32 Pins) {
+    return (0UL | ... | dualPotMask(I, Pins));
+}
+
+} // namespace detail
+
+template <u8 Channels>
+class DualPot {
+    static_assert((0U < Channels) && (Channels <= DUALPOT_CH_QUAN), "DualPot: channels beyond DUALPOT_CH_QUAN");
+
+public:
+    static constexpr u8 ChannelQuan = Channels;
+    static constexpr f32 MinResistance = MIN_RESISTANCE;
+    static constexpr f32 MaxResistance = MAX_RESISTANCE;
+    static constexpr u32 Rate = (u32)TIMER_FREQ;            /* timer ticks per second */
+
+    /* port bits of one channel (chA..), and of every channel in use */
+    static constexpr u32 CsMask(u8 Channel)  { return detail::dualPotMask(Channel - chA, 1U); }
+    static constexpr u32 UdMask(u8 Channel)  { return detail::dualPotMask(Channel - chA, 2U); }
+    static constexpr u32 IncMask(u8 Channel) { return detail::dualPotMask(Channel - chA, 4U); }
+    static constexpr u32 PortMask = detail::dualPotMaskAll(std::make_index_sequence<Channels>{}, 7U);
+    /* pins high on a released channel: CS and INC; U/D keeps its last level */
+    static constexpr u32 ReleasedMask = detail::dualPotMaskAll(std::make_index_sequence<Channels>{}, 5U);
+
+    static constexpr bool InRange(f32 Resistance) {
+        return (Resistance >= MIN_RESISTANCE) && (Resistance <= MAX_RESISTANCE);
+    }
+
+    /* same truncation as the C driver, see DUALPOT_TAP */
+    static constexpr u8 Tap(f32 Resistance) { return DUALPOT_TAP(Resistance); }
+
+    /* timer ticks covering a time, rounded up */
+    static constexpr u32 Ticks(u32 Us) {
+        return (u32)(((u64)Us * Rate + 999999ULL) / 1000000ULL);
+    }
+    static constexpr u32 TicksMs(u32 Ms) { return Ticks(Ms * 1000U); }
+
+    /* setpoint of a constant resistance: an out of range resistance does not
+     * compile in a constant expression, at run time it gives channel 0 */
+    template <u8 Channel>
+    static constexpr DualPotSetpoint At(f32 Resistance) {
+        static_assert((Channel >= chA) && (Channel < (chA + Channels)), "DualPot::At: channel not in use");
+        return InRange(Resistance) ?
+               DualPotSetpoint{Channel, Tap(Resistance), CsMask(Channel), UdMask(Channel), IncMask(Channel)} :
+               rangeError();
+    }
+
+    static void Init(void)   { DualPotDrv_Init(); }
+    static void DeInit(void) { DualPotDrv_DeInit(); }
+
+    /* warm restart, see DualPotDrv_InitWarm/DeInitWarm */
+    static bool Init(const DualPotWarmT &Warm) { return 0U != DualPotDrv_InitWarm(&Warm); }
+    static void DeInit(DualPotWarmT &Warm)     { DualPotDrv_DeInitWarm(&Warm); }
+
+    /* DualPotDrv_MainDeadline without the conversion; True once the channel
+     * stopped at the tap */
+    static bool Move(const DualPotSetpoint &Setpoint, u32 Deadline = 0U) {
+        return 0U != DualPotDrv_MainTap(Setpoint.Channel, Setpoint.Tap, Deadline);
+    }
+
+    /* run time resistance, range checked and counted by the C driver */
+    static bool Move(u8 Channel, f32 Resistance, u32 Deadline = 0U) {
+        return 0U != DualPotDrv_MainDeadline(Channel, Resistance, Deadline);
+    }
+
+    /* one request per channel in use, chA first; True once all stopped */
+    static bool MoveAll(const DualPotSetpoint (&Setpoint)[Channels], u32 Deadline = 0U) {
+        return moveAll(Setpoint, Deadline, std::make_index_sequence<Channels>{});
+    }
+    static bool MoveAll(const f32 (&Resistance)[Channels], u32 Deadline = 0U) {
+        return moveAll(Resistance, Deadline, std::make_index_sequence<Channels>{});
+    }
+
+    /* DualPotDrv_Resync: through the nearer end stop, then on to the last
+     * request; poll it with Move */
+    static bool Resync(u8 Channel) { return 0U != DualPotDrv_Resync(Channel); }
+
+    /* taps the channels in use are at, from one status snapshot */
+    static void Taps(u8 (&Tap)[Channels]) {
+        DualPotStatusT status;
+
+        DualPotDrv_GetStatus(&status);
+        taps(status, Tap, std::make_index_sequence<Channels>{});
+    }
+
+private:
+    /* not constexpr: reaching it stops constant evaluation */
+    static DualPotSetpoint rangeError(void) { return DualPotSetpoint{0U, 0U, 0U, 0U, 0U}; }
+
+    /* every channel gets its request, no short circuit */
+    template <std::size_t... I>
+    static bool moveAll(const DualPotSetpoint (&Setpoint)[Channels], u32 Deadline, std::index_sequence<I...>) {
+        return (true & ... & Move(Setpoint[I], Deadline));
+    }
+    template <std::size_t... I>
+    static bool moveAll(const f32 (&Resistance)[Channels], u32 Deadline, std::index_sequence<I...>) {
+        return (true & ... & Move((u8)(chA + I), Resistance[I], Deadline));
+    }
+
+    template <std::size_t... I>
+    static void taps(const DualPotStatusT &Status, u8 (&Tap)[Channels], std::index_sequence<I...>) {
+        ((Tap[I] = Status.Ch[I].CurrTap), ...);
+    }
+};
+
+} // namespace motiv
+
+#endif //MOTIV_DUALPOT_HPP
@@ -0,0 +1,287 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Batch.c
+* DESCRIPTION : Batch resistance/tap conversion for setpoint processing
+* PUBLIC FUNCTIONS :
+*           size_t DualPotDrv_GetTapBatch(const f32 *resistance, u8 *tap, size_t n)
+*           void DualPotDrv_GetResistanceBatch(const u8 *tap, f32 *resistance, size_t n)
+*           void DualPotDrv_BatchIsaSet(DualPotBatchIsaT isa)
+*           DualPotBatchIsaT DualPotDrv_BatchIsa(void)
+* NOTES : Applies the range check of DualPotDrv_Main and the getTap
+*         mapping (DUALPOT_TAP) to whole arrays. The SSE2 and AVX paths
+*         issue the same single precision divide, multiply and truncating
+*         conversion per sample as the scalar path, so all paths return
+*         bit-identical taps. The fastest path the CPU supports is picked
+*         on first use.
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   Batch conversion with SSE2/AVX paths
+* 0.1.1   18Oct2026   agent   Thread local tap table and path
+*H***********************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include "DualPot_Dev.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BATCH_X86 1
+#include <immintrin.h>
+#else
+#define BATCH_X86 0
+#endif
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+static SyncLocal DualPotBatchIsaT batchIsa = DualPotBatchAuto; /* path in use, resolved on first call */
+
+static SyncLocal f32 tapRes[FULL_TAP + 1U]; /* lowest resistance mapping to each tap */
+static SyncLocal volatile bool tapResReady = False; /* tapRes has been filled */
+
+/******************************************************************************
+ *	local functions
+ ******************************************************************************/
+static DualPotBatchIsaT batchResolve(void);
+static size_t tapScalar(const f32 *resistance, u8 *tap, size_t n);
+static void tapResInit(void);
+static f32 stepFloat(f32 value, s32 dir);
+#if BATCH_X86
+static size_t tapSse2(const f32 *resistance, u8 *tap, size_t n);
+static size_t tapAvx(const f32 *resistance, u8 *tap, size_t n);
+#endif
+
+/********************************************************************
+* FUNCTION   : size_t DualPotDrv_GetTapBatch(const f32 *resistance, u8 *tap, size_t n)
+* PURPOSE    : Convert resistances to tap values
+* PARAMETERS : const f32 *resistance    //n resistances
+*              u8 *tap                  //n tap values out
+*              size_t n                 //number of samples
+* RETURN     : size_t                   //samples converted; stops at the first
+*                                       //resistance DualPotDrv_Main would reject
+**********************************************************************/
+size_t DualPotDrv_GetTapBatch(const f32 *resistance, u8 *tap, size_t n){
+    size_t done = 0U;
+
+    switch(batchResolve()){
+#if BATCH_X86
+        case DualPotBatchAvx:
+            done = tapAvx(resistance, tap, n);
+            break;
+        case DualPotBatchSse2:
+            done = tapSse2(resistance, tap, n);
+            break;
+#endif
+        default:
+            break;
+    }
+
+    /* remainder, or the sample that failed the range check */
+    return done + tapScalar(&resistance[done], &tap[done], n - done);
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotDrv_GetResistanceBatch(const u8 *tap, f32 *resistance, size_t n)
+* PURPOSE    : Convert tap values to resistances
+* PARAMETERS : const u8 *tap            //n tap values
+*              f32 *resistance          //n resistances out
+*              size_t n                 //number of samples
+* RETURN     : void
+* NOTE       : returns the lowest resistance that maps back to the tap, so
+*              a round trip through DualPotDrv_GetTapBatch is exact
+**********************************************************************/
+void DualPotDrv_GetResistanceBatch(const u8 *tap, f32 *resistance, size_t n){
+    size_t i;
+
+    if(False == tapResReady){
+        tapResInit();
+    }
+
+    for(i = 0U; i < n; i++){
+        resistance[i] = tapRes[tap[i]];
+    }
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotDrv_BatchIsaSet(DualPotBatchIsaT isa)
+* PURPOSE    : Force a conversion path, DualPotBatchAuto picks the fastest
+* PARAMETERS : DualPotBatchIsaT isa     //requested path
+* RETURN     : void
+**********************************************************************/
+void DualPotDrv_BatchIsaSet(DualPotBatchIsaT isa){
+
+    batchIsa = isa;
+}
+
+/********************************************************************
+* FUNCTION   : DualPotBatchIsaT DualPotDrv_BatchIsa(void)
+* PURPOSE    : Conversion path in use
+* PARAMETERS : void
+* RETURN     : DualPotBatchIsaT
+**********************************************************************/
+DualPotBatchIsaT DualPotDrv_BatchIsa(void){
+
+    return batchResolve();
+}
+
+/********************************************************************
+* FUNCTION   : static DualPotBatchIsaT batchResolve(void)
+* PURPOSE    : Resolve DualPotBatchAuto and unsupported requests
+* PARAMETERS : void
+* RETURN     : DualPotBatchIsaT
+**********************************************************************/
+static DualPotBatchIsaT batchResolve(void){
+    DualPotBatchIsaT best = DualPotBatchScalar;
+
+#if BATCH_X86
+    if(0 != __builtin_cpu_supports("sse2")){
+        best = DualPotBatchSse2;
+    }
+    if(0 != __builtin_cpu_supports("avx")){
+        best = DualPotBatchAvx;
+    }
+#endif
+
+    if((DualPotBatchAuto == batchIsa) || (batchIsa > best)){
+        batchIsa = best;
+    }
+    return batchIsa;
+}
+
+/********************************************************************
+* FUNCTION   : static size_t tapScalar(const f32 *resistance, u8 *tap, size_t n)
+* PURPOSE    : Portable conversion, reference for the vector paths
+* PARAMETERS : see DualPotDrv_GetTapBatch
+* RETURN     : size_t
+**********************************************************************/
+static size_t tapScalar(const f32 *resistance, u8 *tap, size_t n){
+    size_t i;
+
+    for(i = 0U; i < n; i++){
+        /* same range check as DualPotDrv_Main */
+        if(!((resistance[i] >= MIN_RESISTANCE) && (resistance[i] <= MAX_RESISTANCE))){
+            break;
+        }
+        tap[i] = DUALPOT_TAP(resistance[i]);
+    }
+    return i;
+}
+
+#if BATCH_X86
+/********************************************************************
+* FUNCTION   : static size_t tapSse2(const f32 *resistance, u8 *tap, size_t n)
+* PURPOSE    : SSE2 conversion, 8 samples per step
+* PARAMETERS : see DualPotDrv_GetTapBatch
+* RETURN     : size_t                   //samples converted, the scalar path
+*                                       //finishes the rest
+**********************************************************************/
+__attribute__((target("sse2")))
+static size_t tapSse2(const f32 *resistance, u8 *tap, size_t n){
+    const __m128 lo = _mm_set1_ps(MIN_RESISTANCE);
+    const __m128 hi = _mm_set1_ps(MAX_RESISTANCE);
+    const __m128 div = _mm_set1_ps(MAX_RESISTANCE);
+    const __m128 mul = _mm_set1_ps((f32)FULL_TAP);
+    __m128 r0, r1;
+    __m128 ok;
+    __m128i t;
+    size_t i;
+
+    for(i = 0U; (i + 8U) <= n; i += 8U){
+        r0 = _mm_loadu_ps(&resistance[i]);
+        r1 = _mm_loadu_ps(&resistance[i + 4U]);
+
+        /* ordered compares, NaN fails the range check like in DualPotDrv_Main */
+        ok = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(r0, lo), _mm_cmple_ps(r0, hi)),
+                        _mm_and_ps(_mm_cmpge_ps(r1, lo), _mm_cmple_ps(r1, hi)));
+        if(0xF != _mm_movemask_ps(ok)){
+            break;
+        }
+
+        t = _mm_packs_epi32(_mm_cvttps_epi32(_mm_mul_ps(_mm_div_ps(r0, div), mul)),
+                            _mm_cvttps_epi32(_mm_mul_ps(_mm_div_ps(r1, div), mul)));
+        _mm_storel_epi64((__m128i *)(void *)&tap[i], _mm_packus_epi16(t, t));
+    }
+    return i;
+}
+
+/********************************************************************
+* FUNCTION   : static size_t tapAvx(const f32 *resistance, u8 *tap, size_t n)
+* PURPOSE    : AVX conversion, 16 samples per step
+* PARAMETERS : see DualPotDrv_GetTapBatch
+* RETURN     : size_t                   //samples converted, the scalar path
+*                                       //finishes the rest
+**********************************************************************/
+__attribute__((target("avx")))
+static size_t tapAvx(const f32 *resistance, u8 *tap, size_t n){
+    const __m256 lo = _mm256_set1_ps(MIN_RESISTANCE);
+    const __m256 hi = _mm256_set1_ps(MAX_RESISTANCE);
+    const __m256 div = _mm256_set1_ps(MAX_RESISTANCE);
+    const __m256 mul = _mm256_set1_ps((f32)FULL_TAP);
+    __m256 r0, r1;
+    __m256 ok;
+    __m256i t0, t1;
+    __m128i p0, p1;
+    size_t i;
+
+    for(i = 0U; (i + 16U) <= n; i += 16U){
+        r0 = _mm256_loadu_ps(&resistance[i]);
+        r1 = _mm256_loadu_ps(&resistance[i + 8U]);
+
+        /* ordered, non-signalling compares, NaN fails the range check */
+        ok = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(r0, lo, _CMP_GE_OQ), _mm256_cmp_ps(r0, hi, _CMP_LE_OQ)),
+                           _mm256_and_ps(_mm256_cmp_ps(r1, lo, _CMP_GE_OQ), _mm256_cmp_ps(r1, hi, _CMP_LE_OQ)));
+        if(0xFF != _mm256_movemask_ps(ok)){
+            break;
+        }
+
+        t0 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_div_ps(r0, div), mul));
+        t1 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_div_ps(r1, div), mul));
+
+        /* no 256 bit integer packs on AVX, narrow the 128 bit halves */
+        p0 = _mm_packs_epi32(_mm256_castsi256_si128(t0), _mm256_extractf128_si256(t0, 1));
+        p1 = _mm_packs_epi32(_mm256_castsi256_si128(t1), _mm256_extractf128_si256(t1, 1));
+        _mm_storeu_si128((__m128i *)(void *)&tap[i], _mm_packus_epi16(p0, p1));
+    }
+    return i;
+}
+#endif
+
+/********************************************************************
+* FUNCTION   : static void tapResInit(void)
+* PURPOSE    : Fill tapRes with the lowest resistance mapping to each tap
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+static void tapResInit(void){
+    f32 res;
+    u16 tap;
+
+    for(tap = 0U; tap <= FULL_TAP; tap++){
+        res = (f32)tap * MAX_RESISTANCE / (f32)FULL_TAP;
+
+        /* nominal value may truncate to a neighbour tap, walk to the bin edge */
+        while(DUALPOT_TAP(res) < tap){
+            res = stepFloat(res, 1);
+        }
+        while((res > MIN_RESISTANCE) && (DUALPOT_TAP(stepFloat(res, -1)) == tap)){
+            res = stepFloat(res, -1);
+        }
+        tapRes[tap] = res;
+    }
+    tapResReady = True;
+}
+
+/********************************************************************
+* FUNCTION   : static f32 stepFloat(f32 value, s32 dir)
+* PURPOSE    : Neighbouring single precision value of a positive float
+* PARAMETERS : f32 value                //value >= 0
+*              s32 dir                  //1 next larger, -1 next smaller
+* RETURN     : f32
+**********************************************************************/
+static f32 stepFloat(f32 value, s32 dir){
+    union { f32 f; u32 u; } bits;
+
+    bits.f = value;
+    bits.u = (u32)((s32)bits.u + dir);
+    return bits.f;
+}
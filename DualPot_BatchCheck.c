@@ -0,0 +1,150 @@
+/*H**********************************************************************
+* FILENAME : DualPot_BatchCheck.c
+* DESCRIPTION : Exhaustive check of the batch resistance/tap conversion
+* NOTES : Feeds every one of the 2^32 single precision bit patterns
+*         (NaNs, infinities, denormals and -0 included) through
+*         DualPotDrv_GetTapBatch on each path the CPU supports and
+*         compares against the driver's own range check and DUALPOT_TAP:
+*         - a call stops exactly at the first sample DualPotDrv_Main
+*           would reject;
+*         - every tap it returns is bit-identical to DUALPOT_TAP.
+*         Patterns are checked a block at a time, each path sees the
+*         same block at the same offsets. -p restricts the check to one
+*         path (0 scalar, 1 SSE2, 2 AVX), -f/-t to a bit pattern range.
+*         usage: DualPot_BatchCheck [-p path] [-f first] [-t last]
+*         Exits with 1 on the first mismatch.
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "DualPot_Drv.h"
+
+#define BATCHCHECK_BLOCK (1UL << 20)    /* bit patterns per block */
+
+static const char *const isaName[] = {"scalar", "SSE2", "AVX"};
+
+static f32 res[BATCHCHECK_BLOCK];
+static u8 refTap[BATCHCHECK_BLOCK];     /* DUALPOT_TAP of each valid sample */
+static u32 runEnd[BATCHCHECK_BLOCK];    /* first rejected sample at or after each one */
+static u8 tap[BATCHCHECK_BLOCK];
+
+/* reference of one block: range check of DualPotDrv_Main, then DUALPOT_TAP */
+static void reference(u64 First, u32 Quan){
+    u32 bits;
+    u32 end = Quan;
+    u32 i;
+
+    for(i = 0U; i < Quan; i++){
+        bits = (u32)(First + i);
+        memcpy(&res[i], &bits, sizeof(bits));
+        if((res[i] >= MIN_RESISTANCE) && (res[i] <= MAX_RESISTANCE)){
+            refTap[i] = DUALPOT_TAP(res[i]);
+        }
+    }
+    for(i = Quan; i > 0U; i--){
+        if(!((res[i - 1U] >= MIN_RESISTANCE) && (res[i - 1U] <= MAX_RESISTANCE))){
+            end = i - 1U;
+        }
+        runEnd[i - 1U] = end;
+    }
+}
+
+/* one block on the selected path; False on the first mismatch */
+static bool check(u64 First, u32 Quan, DualPotBatchIsaT Isa){
+    size_t done;
+    u32 k = 0U;
+    u32 i;
+
+    memset(tap, 0, Quan);
+    while(k < Quan){
+        done = DualPotDrv_GetTapBatch(&res[k], &tap[k], Quan - k);
+        if(done != (size_t)(runEnd[k] - k)){
+            printf("%s: call at 0x%08llx converted %zu samples, range check allows %u\n", isaName[Isa],
+                   First + k, done, runEnd[k] - k);
+            return False;
+        }
+        for(i = k; i < runEnd[k]; i++){
+            if(tap[i] != refTap[i]){
+                printf("%s: 0x%08llx (%.9g) gives tap %u, DUALPOT_TAP %u\n", isaName[Isa],
+                       First + i, (double)res[i], tap[i], refTap[i]);
+                return False;
+            }
+        }
+        k = runEnd[k] + 1U;                 /* past the rejected sample */
+    }
+    return True;
+}
+
+int main(int argc, char *argv[]) {
+    bool run[DualPotBatchAuto] = {True, True, True};
+    u64 first = 0U;
+    u64 last = 0xFFFFFFFFULL;
+    u64 valid = 0U;
+    u64 b;
+    u32 quan;
+    u32 i;
+    int isa;
+    int opt;
+
+    while(-1 != (opt = getopt(argc, argv, "p:f:t:"))){
+        switch(opt){
+        case 'p':
+            isa = atoi(optarg);
+            if((isa < (int)DualPotBatchScalar) || (isa >= (int)DualPotBatchAuto)){
+                fprintf(stderr, "-p wants 0 (scalar), 1 (SSE2) or 2 (AVX)\n");
+                return 2;
+            }
+            memset(run, 0, sizeof(run));
+            run[isa] = True;
+            break;
+        case 'f':
+            first = strtoull(optarg, 0, 0);
+            break;
+        case 't':
+            last = strtoull(optarg, 0, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-p path] [-f first] [-t last]\n", argv[0]);
+            return 2;
+        }
+    }
+    if((last > 0xFFFFFFFFULL) || (first > last)){
+        fprintf(stderr, "-f/-t want bit patterns 0 <= first <= last <= 0xffffffff\n");
+        return 2;
+    }
+
+    for(isa = (int)DualPotBatchScalar; isa < (int)DualPotBatchAuto; isa++){
+        DualPotDrv_BatchIsaSet((DualPotBatchIsaT)isa);
+        if((True == run[isa]) && ((int)DualPotDrv_BatchIsa() != isa)){
+            printf("%s: not supported by this CPU, skipped\n", isaName[isa]);
+            run[isa] = False;
+        }/*ELSE: Do nothing*/
+    }
+
+    for(b = first; b <= last; b += quan){
+        quan = ((last - b + 1U) < BATCHCHECK_BLOCK) ? (u32)(last - b + 1U) : (u32)BATCHCHECK_BLOCK;
+        reference(b, quan);
+        for(i = 0U; i < quan; i++){
+            valid += (runEnd[i] != i) ? 1U : 0U;
+        }
+        for(isa = (int)DualPotBatchScalar; isa < (int)DualPotBatchAuto; isa++){
+            if(True == run[isa]){
+                DualPotDrv_BatchIsaSet((DualPotBatchIsaT)isa);
+                if(False == check(b, quan, (DualPotBatchIsaT)isa)){
+                    return 1;
+                }
+            }/*ELSE: Do nothing*/
+        }
+    }
+
+    printf("bit patterns 0x%08llx..0x%08llx, %llu in range:", first, last, (unsigned long long)valid);
+    for(isa = (int)DualPotBatchScalar; isa < (int)DualPotBatchAuto; isa++){
+        if(True == run[isa]){
+            printf(" %s", isaName[isa]);
+        }/*ELSE: Do nothing*/
+    }
+    printf(" bit-identical to DUALPOT_TAP\n");
+    return 0;
+}
@@ -0,0 +1,217 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Bench.c
+* DESCRIPTION : Host benchmark for the DualPot driver hot paths
+* NOTES : Reports the cost of one ISR_Timer25us_Handler tick with both
+*         channels moving, of a single PinWrite and of DualPotDrv_Init
+*         with the port writes it issues, in CycleNow() units.
+*         Built for the REGS and INLINE HALs; configure a Release build
+*         and compare the two to see the cost of out-of-line HAL calls.
+*         Also reports batch resistance to tap conversion throughput for
+*         every path DualPotDrv_GetTapBatch supports on this CPU.
+*         -c sweeps startup over channel counts instead: DUALPOT_CH_QUAN is
+*         fixed by the pin tables, so the register sequence of the old
+*         init (chip select per channel, timer set up eagerly) and of the
+*         new one (one port write, timer left alone) is replayed for 1 to
+*         BENCH_CH_MAX channels on the HalRegs.h accessors.
+*         usage: DualPot_Bench [-c]
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#include <stdio.h>
+#include <unistd.h>
+#include "DualPot_Drv.h"
+#include "HalRegs.h"
+#include "Cycle.h"
+
+#define BENCH_LOOPS 1000000UL           /* calls per timed run */
+#define BENCH_RUNS  20U                 /* timed runs, best one is reported */
+#define BENCH_SAMPLES (1UL << 20)       /* samples per batch conversion */
+#define BENCH_INITS 10000UL             /* DualPotDrv_Init calls per timed run */
+#define BENCH_BLOCK 256UL               /* ticks per move, half an end to end move */
+#define BENCH_CH_MAX 10U                /* channels of 3 pins on a 32 bit port */
+#define BENCH_TIMER_REGS 8U             /* timer register accesses of the old init */
+
+#ifdef HAL_INLINE
+#define BENCH_HAL "inline"
+#else
+#define BENCH_HAL "out-of-line"
+#endif
+
+void ISR_Timer25us_Handler(void);
+
+static f32 batchRes[BENCH_SAMPLES];     /* batch conversion input */
+static u8 batchTap[BENCH_SAMPLES];      /* batch conversion output */
+static const char *const isaName[] = {"scalar", "sse2", "avx"};
+static u8 sweepChans;                   /* channels of the startup sweep */
+
+/* best per-call cost of Fn over BENCH_RUNS runs of Loops calls */
+static double benchBest(void (*Fn)(u32 Loops), u32 Loops){
+    u64 best = ~0ULL;
+    u64 start;
+    u64 took;
+    u8 run;
+
+    for(run = 0U; run < BENCH_RUNS; run++){
+        start = CycleNow();
+        Fn(Loops);
+        took = CycleNow() - start;
+        if(took < best){
+            best = took;
+        }
+    }
+    return (double)best / (double)Loops;
+}
+
+/* best per-tick cost over BENCH_RUNS runs of Loops ticks. Both channels
+ * get a move towards the opposite end every BENCH_BLOCK ticks, before
+ * they reach it, so every timed tick steps both. The requests are not
+ * timed */
+static double benchIsr(u32 Loops){
+    u64 best = ~0ULL;
+    u64 took;
+    u64 start;
+    u32 block;
+    u32 i;
+    u8 run;
+    bool up = False;
+
+    for(run = 0U; run < BENCH_RUNS; run++){
+        took = 0U;
+        for(block = 0U; block < (Loops / BENCH_BLOCK); block++){
+            up = (True == up) ? False : True;
+            (void)DualPotDrv_Main(chA, (True == up) ? MAX_RESISTANCE : 0);
+            (void)DualPotDrv_Main(chB, (True == up) ? 0 : MAX_RESISTANCE);
+            start = CycleNow();
+            for(i = 0U; i < BENCH_BLOCK; i++){
+                ISR_Timer25us_Handler();
+            }
+            took += CycleNow() - start;
+        }
+        if(took < best){
+            best = took;
+        }
+    }
+    return (double)best / (double)((Loops / BENCH_BLOCK) * BENCH_BLOCK);
+}
+
+static void benchBatch(u32 Loops){
+    u32 i;
+
+    for(i = 0U; i < Loops; i++){
+        (void)DualPotDrv_GetTapBatch(batchRes, batchTap, BENCH_SAMPLES);
+    }
+}
+
+static void benchInit(u32 Loops){
+    u32 i;
+
+    for(i = 0U; i < Loops; i++){
+        DualPotDrv_Init();
+    }
+}
+
+/* the old init at sweepChans channels: timer set up and interrupt enabled
+ * at startup, one chip select write per channel */
+static void benchInitSerial(u32 Loops){
+    u32 i;
+    u8 ch;
+
+    for(i = 0U; i < Loops; i++){
+        HalPeriodicModuleInit();
+        HalPeriodicIruptDisable();
+        HalPinModuleInit();
+        HalPeriodicConfig(TIMER_FREQ, ISR_Timer25us_Handler);
+        for(ch = 0U; ch < sweepChans; ch++){
+            HalPinWrite((u8)(3U * ch), True);
+        }
+        HalPeriodicIruptEnable();
+    }
+}
+
+/* the new init at sweepChans channels: CS, U/D and INC of every channel in
+ * one port write, the timer untouched until the first move */
+static void benchInitBatched(u32 Loops){
+    u32 mask = (1UL << (3U * sweepChans)) - 1UL;    /* pins 3n CS, 3n+1 U/D, 3n+2 INC */
+    u32 level = mask & 0x2DB6DB6DUL;                /* CS and INC high, U/D low */
+    u32 i;
+
+    for(i = 0U; i < Loops; i++){
+        HalPinModuleInit();
+        HalPinWriteMask(mask, level);
+    }
+}
+
+/* startup against channel count, the old init next to the new one */
+static void sweepInit(void){
+    double serial;
+    double batched;
+
+    printf("hal=%s, startup register sequence by channel count\n", BENCH_HAL);
+    printf("channels   old: accesses  cycles   new: accesses  cycles\n");
+    for(sweepChans = 1U; sweepChans <= BENCH_CH_MAX; sweepChans++){
+        serial = benchBest(benchInitSerial, BENCH_LOOPS);
+        batched = benchBest(benchInitBatched, BENCH_LOOPS);
+        printf("%8u        %8u  %6.1f        %8u  %6.1f\n", sweepChans,
+               1U + sweepChans + BENCH_TIMER_REGS, serial, 2U, batched);
+    }
+}
+
+static void benchPinWrite(u32 Loops){
+    u32 i;
+
+    for(i = 0U; i < Loops; i++){
+        PinWrite(PinINCA, (bool)(i & 1U));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    DualPotBatchIsaT isa;
+    DualPotBatchIsaT best;
+    double initCycles;
+    u32 i;
+    u32 seed = 1U;
+#ifndef HAL_INLINE
+    PinStatsT pins;
+#endif
+    int opt;
+
+    while(-1 != (opt = getopt(argc, argv, "c"))){
+        if('c' == opt){
+            sweepInit();
+            return 0;
+        }
+        fprintf(stderr, "usage: %s [-c]\n", argv[0]);
+        return 2;
+    }
+
+    initCycles = benchBest(benchInit, BENCH_INITS);
+#ifndef HAL_INLINE
+    PinStatsClear();
+    DualPotDrv_Init();
+    PinStatsGet(&pins);
+#endif
+
+    printf("hal=%s layout=%d\n", BENCH_HAL, DUALPOT_LAYOUT);
+    printf("ISR tick, 2 channels moving  : %6.1f cycles\n", benchIsr(BENCH_LOOPS));
+    printf("PinWrite                     : %6.1f cycles\n", benchBest(benchPinWrite, BENCH_LOOPS));
+#ifndef HAL_INLINE
+    printf("DualPotDrv_Init              : %6.1f cycles, %u port writes\n", initCycles, pins.BusWrites);
+#else
+    printf("DualPotDrv_Init              : %6.1f cycles\n", initCycles);
+#endif
+
+    DualPotDrv_DeInit();
+
+    /* recorded profiles span the whole range */
+    for(i = 0U; i < BENCH_SAMPLES; i++){
+        seed = seed * 1103515245U + 12345U;
+        batchRes[i] = (f32)(seed >> 8) / (f32)(1UL << 24) * MAX_RESISTANCE;
+    }
+
+    best = DualPotDrv_BatchIsa();
+    for(isa = DualPotBatchScalar; isa <= best; isa++){
+        DualPotDrv_BatchIsaSet(isa);
+        printf("GetTapBatch %-6s            : %6.2f cycles/sample\n", isaName[isa],
+               benchBest(benchBatch, 1U) / (double)BENCH_SAMPLES);
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Client.c
+* DESCRIPTION : Command line client of dualpotd
+* NOTES : set: one request, waits for its response.
+*         load: -n random requests with up to -w of them outstanding;
+*         reports requests/s, results and round trip latency. Start
+*         several at once to see dualpotd coalesce their requests.
+*         usage: DualPot_Client [-s socket] set channel resistance
+*                DualPot_Client [-s socket] [-n requests] [-w window] load
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "DualPot_Drv.h"
+#include "DualPot_Sock.h"
+
+static const char *const resultName[] = {"done", "superseded", "rejected"};
+
+static u64 nowNs(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+static int connectTo(const char *Path){
+    struct sockaddr_un addr;
+    int fd;
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0){
+        perror("socket");
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, Path, sizeof(addr.sun_path) - 1U);
+    if(0 != connect(fd, (const struct sockaddr *)&addr, sizeof(addr))){
+        perror(Path);
+        (void)close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* whole records only, the stream may split them */
+static bool recvAll(int Fd, void *Buf, size_t Len){
+    size_t got = 0U;
+    ssize_t n;
+
+    while(got < Len){
+        n = recv(Fd, (u8 *)Buf + got, Len - got, 0);
+        if(n <= 0){
+            return False;
+        }
+        got += (size_t)n;
+    }
+    return True;
+}
+
+static int cmpU64(const void *A, const void *B){
+    u64 a = *(const u64 *)A;
+    u64 b = *(const u64 *)B;
+
+    return (a > b) - (a < b);
+}
+
+static int set(int Fd, u8 Channel, f32 Resistance){
+    DualPotReqMsgT req;
+    DualPotRspMsgT rsp;
+
+    memset(&req, 0, sizeof(req));
+    req.Id = 1U;
+    req.Op = DUALPOT_OP_SET;
+    req.Channel = Channel;
+    req.Resistance = Resistance;
+    if(((ssize_t)sizeof(req) != send(Fd, &req, sizeof(req), 0)) || (False == recvAll(Fd, &rsp, sizeof(rsp)))){
+        fprintf(stderr, "dualpotd went away\n");
+        return 1;
+    }
+    printf("ch%u %s at tap %u after %u us\n", rsp.Channel,
+           (rsp.Result <= DUALPOT_RSP_REJECTED) ? resultName[rsp.Result] : "?", rsp.Tap, rsp.LatencyUs);
+    return (DUALPOT_RSP_REJECTED == rsp.Result) ? 1 : 0;
+}
+
+static int load(int Fd, u32 Requests, u32 Window){
+    DualPotReqMsgT req;
+    DualPotRspMsgT rsp;
+    u64 *sentNs;
+    u64 *rtt;
+    u64 result[DUALPOT_RSP_REJECTED + 1U] = {0U, 0U, 0U};
+    u64 daemonUs = 0U;
+    u64 start;
+    u64 took;
+    u32 seed = (u32)getpid();
+    u32 sent = 0U;
+    u32 got = 0U;
+
+    sentNs = (u64 *)calloc(Requests, sizeof(u64));
+    rtt = (u64 *)calloc(Requests, sizeof(u64));
+    if((0 == sentNs) || (0 == rtt)){
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    start = nowNs();
+    while(got < Requests){
+        while((sent < Requests) && ((sent - got) < Window)){
+            seed = seed * 1103515245U + 12345U;
+            memset(&req, 0, sizeof(req));
+            req.Id = sent;
+            req.Op = DUALPOT_OP_SET;
+            req.Channel = (u8)(chA + ((seed >> 8) % DUALPOT_CH_QUAN));
+            req.Resistance = (f32)((seed >> 12) % 10001U);
+            sentNs[sent] = nowNs();
+            if((ssize_t)sizeof(req) != send(Fd, &req, sizeof(req), 0)){
+                fprintf(stderr, "dualpotd went away\n");
+                return 1;
+            }
+            sent++;
+        }
+        if((False == recvAll(Fd, &rsp, sizeof(rsp))) || (rsp.Id >= sent)){
+            fprintf(stderr, "dualpotd went away\n");
+            return 1;
+        }
+        rtt[got] = nowNs() - sentNs[rsp.Id];
+        if(rsp.Result <= DUALPOT_RSP_REJECTED){
+            result[rsp.Result]++;
+        }
+        daemonUs += rsp.LatencyUs;
+        got++;
+    }
+    took = nowNs() - start;
+
+    qsort(rtt, Requests, sizeof(u64), cmpU64);
+    printf("%u requests in %.3f s: %.0f requests/s, done %llu, superseded %llu, rejected %llu\n",
+           Requests, (double)took / 1e9, (double)Requests * 1e9 / (double)took,
+           (unsigned long long)result[DUALPOT_RSP_DONE], (unsigned long long)result[DUALPOT_RSP_SUPERSEDED],
+           (unsigned long long)result[DUALPOT_RSP_REJECTED]);
+    printf("round trip p50 %.0f us  p99 %.0f us  max %.0f us, in the daemon mean %.0f us\n",
+           (double)rtt[Requests / 2U] / 1e3, (double)rtt[(u32)((u64)Requests * 99U / 100U)] / 1e3,
+           (double)rtt[Requests - 1U] / 1e3, (double)daemonUs / (double)Requests);
+    free(sentNs);
+    free(rtt);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    char defPath[sizeof(((struct sockaddr_un *)0)->sun_path) + 1U];
+    const char *path = DualPotSockPath(defPath, sizeof(defPath));
+    u32 requests = 1000U;
+    u32 window = 8U;
+    int fd;
+    int rc = 2;
+    int opt;
+
+    while(-1 != (opt = getopt(argc, argv, "s:n:w:"))){
+        switch(opt){
+        case 's':
+            path = optarg;
+            break;
+        case 'n':
+            requests = (u32)strtoul(optarg, 0, 10);
+            break;
+        case 'w':
+            window = (u32)strtoul(optarg, 0, 10);
+            break;
+        default:
+            break;
+        }
+    }
+
+    if(((optind + 3) == argc) && (0 == strcmp(argv[optind], "set"))){
+        fd = connectTo(path);
+        if(fd >= 0){
+            rc = set(fd, (u8)atoi(argv[optind + 1]), (f32)atof(argv[optind + 2]));
+            (void)close(fd);
+        }else{
+            rc = 1;
+        }
+    }else if(((optind + 1) == argc) && (0 == strcmp(argv[optind], "load")) && (0U != requests) && (0U != window)){
+        fd = connectTo(path);
+        if(fd >= 0){
+            rc = load(fd, requests, window);
+            (void)close(fd);
+        }else{
+            rc = 1;
+        }
+    }else{
+        fprintf(stderr, "usage: %s [-s socket] set channel resistance\n"
+                        "       %s [-s socket] [-n requests] [-w window] load\n", argv[0], argv[0]);
+    }
+    return rc;
+}
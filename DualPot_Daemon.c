@@ -0,0 +1,657 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Daemon.c
+* DESCRIPTION : dualpotd, owns the DualPot driver and serves local clients
+* NOTES : Listens on a Unix stream socket (DualPot_Sock.h) and serves any
+*         number of client processes from one poll loop, so no client
+*         links the driver or takes a lock around it.
+*         Every loop pass reads all requests the clients have sent and
+*         coalesces them per channel: the latest target wins and one
+*         DualPotDrv_Main call per changed channel submits the batch.
+*         When the move ends each waiting request is answered, DONE if it
+*         asked for the tap reached, else SUPERSEDED.
+*         Keeps per client latency from receipt to response, printed when
+*         a client leaves, on SIGUSR1, every -r seconds and at exit.
+*         With a simulated timer (HAL_SIM) the daemon plays it at wall
+*         clock pace; with DUALPOT_HAL=THREAD or on target the timer runs
+*         by itself.
+*         With -w the driver state is saved to a file at exit and a
+*         restart takes the wipers up from there (DualPotDrv_InitWarm).
+*         The socket is made 0600 in $XDG_RUNTIME_DIR, else in
+*         /run/dualpotd, and a client of another user (SO_PEERCRED) is
+*         refused unless it is root.
+*         usage: dualpotd [-s socket] [-r report seconds] [-w state file]
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "DualPot_Drv.h"
+#include "DualPot_Sock.h"
+#ifdef HAL_SIM
+#include "PeriodicSim.h"
+#endif
+
+#define DAEMON_CLIENTS_MAX 64U          /* clients served at a time */
+#define DAEMON_IN_BUF      4096U        /* request bytes buffered per client */
+#define DAEMON_OUT_BUF     65536U       /* response bytes buffered per client, more drops it */
+#define DAEMON_POLL_NS     100000L      /* loop period while a channel moves */
+#define DAEMON_LAT_BUCKETS 24U          /* latency bucket b: [2^b, 2^(b+1)) us */
+#ifdef HAL_SIM
+#define DAEMON_SIM_MAX     4000U        /* most timer ticks played per pass */
+#endif
+
+typedef struct {
+    u64 Requests;
+    u64 Done;
+    u64 Superseded;
+    u64 Rejected;
+    u64 SumUs;
+    u32 MaxUs;
+    u32 Hist[DAEMON_LAT_BUCKETS];
+} latStatsT;
+
+typedef struct {
+    int Fd;                             /* -1 for a free slot */
+    u32 Gen;                            /* tells waiters of a former client apart */
+    pid_t Pid;                          /* peer process */
+    u32 InLen;
+    u32 OutLen;
+    u8 In[DAEMON_IN_BUF];
+    u8 Out[DAEMON_OUT_BUF];
+    latStatsT Lat;
+} clientT;
+
+/* request waiting for the end of a move */
+typedef struct {
+    u32 Slot;
+    u32 Gen;
+    u32 Id;
+    u8 Tap;                             /* tap requested */
+    u64 RecvNs;
+} waiterT;
+
+typedef struct {
+    waiterT *Wait;
+    u32 WaitQuan;
+    u32 WaitCap;
+    f32 Target;                         /* latest resistance requested */
+    u8 TargetTap;
+    u8 SubmittedTap;                    /* tap of the last DualPotDrv_Main call */
+    bool Changed;                       /* Target not submitted yet */
+    bool Busy;                          /* submitted move not ended yet */
+} chanT;
+
+static clientT client[DAEMON_CLIENTS_MAX];
+static chanT chan[DUALPOT_CH_QUAN];
+static u64 batches;                     /* loop passes submitting at least one channel */
+static u64 submits;                     /* DualPotDrv_Main calls */
+static u64 coalesced;                   /* requests served by another request's move */
+static volatile sig_atomic_t quit;
+static volatile sig_atomic_t reportDue;
+
+static u64 nowNs(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+static void onSignal(int Sig){
+
+    if(SIGUSR1 == Sig){
+        reportDue = 1;
+    }else{
+        quit = 1;
+    }
+}
+
+static void clientClose(u32 Slot);
+
+/* try to send the buffered responses */
+static void clientFlush(u32 Slot){
+    clientT *c = &client[Slot];
+    ssize_t n;
+
+    while(0U != c->OutLen){
+        n = send(c->Fd, c->Out, c->OutLen, MSG_NOSIGNAL);
+        if(n < 0){
+            if((EAGAIN != errno) && (EWOULDBLOCK != errno) && (EINTR != errno)){
+                clientClose(Slot);
+            }
+            return;
+        }
+        memmove(c->Out, c->Out + n, c->OutLen - (u32)n);
+        c->OutLen -= (u32)n;
+    }
+}
+
+/* answer one request and account its latency */
+static void respond(u32 Slot, u32 Gen, u32 Id, u8 Result, u8 Channel, u8 Tap, u64 RecvNs){
+    clientT *c = &client[Slot];
+    DualPotRspMsgT rsp;
+    u64 us;
+    u32 b = 0U;
+
+    if((c->Fd < 0) || (Gen != c->Gen)){
+        return;                             /* the client has gone */
+    }
+    us = (nowNs() - RecvNs) / 1000U;
+    if(us > 0xFFFFFFFFULL){
+        us = 0xFFFFFFFFULL;
+    }
+
+    memset(&rsp, 0, sizeof(rsp));
+    rsp.Id = Id;
+    rsp.LatencyUs = (u32)us;
+    rsp.Result = Result;
+    rsp.Channel = Channel;
+    rsp.Tap = Tap;
+
+    if(DUALPOT_RSP_DONE == Result){
+        c->Lat.Done++;
+    }else if(DUALPOT_RSP_SUPERSEDED == Result){
+        c->Lat.Superseded++;
+    }else{
+        c->Lat.Rejected++;
+    }
+    c->Lat.SumUs += us;
+    if(us > c->Lat.MaxUs){
+        c->Lat.MaxUs = (u32)us;
+    }
+    while((b < (DAEMON_LAT_BUCKETS - 1U)) && ((us >> (b + 1U)) != 0U)){
+        b++;
+    }
+    c->Lat.Hist[b]++;
+
+    if((c->OutLen + sizeof(rsp)) > DAEMON_OUT_BUF){
+        fprintf(stderr, "dualpotd: client %d does not read its responses, dropped\n", (int)c->Pid);
+        clientClose(Slot);
+        return;
+    }
+    memcpy(c->Out + c->OutLen, &rsp, sizeof(rsp));
+    c->OutLen += (u32)sizeof(rsp);
+    clientFlush(Slot);
+}
+
+/* completion callback: answer the requests the move served */
+static void onDone(u8 Channel, u8 Tap){
+    chanT *ch = &chan[Channel - chA];
+    waiterT *w;
+    u32 i;
+    u32 keep = 0U;
+
+    for(i = 0U; i < ch->WaitQuan; i++){
+        w = &ch->Wait[i];
+        if((Tap != ch->SubmittedTap) && (w->Tap == ch->SubmittedTap)){
+            ch->Wait[keep] = *w;            /* an earlier move ended, this one is still on */
+            keep++;
+        }else{
+            respond(w->Slot, w->Gen, w->Id,
+                    (w->Tap == Tap) ? DUALPOT_RSP_DONE : DUALPOT_RSP_SUPERSEDED, Channel, Tap, w->RecvNs);
+        }
+    }
+    ch->WaitQuan = keep;
+    if(Tap == ch->SubmittedTap){
+        ch->Busy = False;
+    }
+}
+
+/* queue a request on its channel, the latest one sets the target */
+static void request(u32 Slot, const DualPotReqMsgT *Req, u64 RecvNs){
+    chanT *ch;
+    waiterT *grown;
+    u8 tap;
+
+    client[Slot].Lat.Requests++;
+    if((DUALPOT_OP_SET != Req->Op) || ((chA != Req->Channel) && (chB != Req->Channel)) ||
+       !((Req->Resistance >= MIN_RESISTANCE) && (Req->Resistance <= MAX_RESISTANCE))){
+        respond(Slot, client[Slot].Gen, Req->Id, DUALPOT_RSP_REJECTED, Req->Channel, 0U, RecvNs);
+        return;
+    }
+
+    ch = &chan[Req->Channel - chA];
+    if(ch->WaitQuan == ch->WaitCap){
+        grown = (waiterT *)realloc(ch->Wait, (ch->WaitCap * 2U + 16U) * sizeof(waiterT));
+        if(0 == grown){
+            respond(Slot, client[Slot].Gen, Req->Id, DUALPOT_RSP_REJECTED, Req->Channel, 0U, RecvNs);
+            return;
+        }
+        ch->Wait = grown;
+        ch->WaitCap = ch->WaitCap * 2U + 16U;
+    }
+    if(0U != ch->WaitQuan){
+        coalesced++;
+    }
+
+    (void)DualPotDrv_GetTapBatch(&Req->Resistance, &tap, 1U);
+    ch->Wait[ch->WaitQuan].Slot = Slot;
+    ch->Wait[ch->WaitQuan].Gen = client[Slot].Gen;
+    ch->Wait[ch->WaitQuan].Id = Req->Id;
+    ch->Wait[ch->WaitQuan].Tap = tap;
+    ch->Wait[ch->WaitQuan].RecvNs = RecvNs;
+    ch->WaitQuan++;
+    ch->Target = Req->Resistance;
+    ch->TargetTap = tap;
+    ch->Changed = True;
+}
+
+/* one DualPotDrv_Main call per channel with a new target */
+static void submit(void){
+    DualPotStatusT status;
+    chanT *ch;
+    bool any = False;
+    u8 idx;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        ch = &chan[idx];
+        if(False == ch->Changed){
+            continue;
+        }
+        ch->Changed = False;
+        if((True == ch->Busy) && (ch->TargetTap == ch->SubmittedTap)){
+            continue;                       /* joins the move under way */
+        }
+
+        DualPotDrv_GetStatus(&status);
+        ch->SubmittedTap = ch->TargetTap;
+        if((False == ch->Busy) && (ch->TargetTap == status.Ch[idx].CurrTap) &&
+           ((Initial == status.Ch[idx].State) || (Stop == status.Ch[idx].State))){
+            onDone((u8)(chA + idx), ch->TargetTap);     /* there already, no move to wait for */
+            continue;
+        }
+        ch->Busy = True;
+        (void)DualPotDrv_Main((u8)(chA + idx), ch->Target);
+        submits++;
+        any = True;
+    }
+    if(True == any){
+        batches++;
+    }
+}
+
+/* a move that ended off its target without a callback for it, when the
+ * timer runs on its own and overtook the request, is submitted again; the
+ * snapshot shows a request to a running timer from its next tick on */
+static void recheck(void){
+    DualPotStatusT status;
+    u8 idx;
+
+    DualPotDrv_GetStatus(&status);
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if((True == chan[idx].Busy) && (False == chan[idx].Changed) && (Stop == status.Ch[idx].State) &&
+           (chan[idx].SubmittedTap == status.Ch[idx].TargetTap) && (chan[idx].SubmittedTap != status.Ch[idx].CurrTap)){
+            chan[idx].Busy = False;
+            chan[idx].Changed = True;
+        }
+    }
+}
+
+/* latency summary of one client */
+static void clientReport(const clientT *C){
+    const latStatsT *l = &C->Lat;
+    u64 n = l->Done + l->Superseded + l->Rejected;
+    u64 seen = 0U;
+    u32 p50 = 0U;
+    u32 p99 = 0U;
+    u32 b;
+
+    for(b = 0U; b < DAEMON_LAT_BUCKETS; b++){
+        seen += l->Hist[b];
+        if((0U == p50) && ((seen * 2U) >= n)){
+            p50 = 2U << b;
+        }
+        if((0U == p99) && ((seen * 100U) >= (n * 99U))){
+            p99 = 2U << b;
+        }
+    }
+    printf("  pid %d: %llu requests, done %llu, superseded %llu, rejected %llu",
+           (int)C->Pid, (unsigned long long)l->Requests, (unsigned long long)l->Done,
+           (unsigned long long)l->Superseded, (unsigned long long)l->Rejected);
+    if(0U != n){
+        printf(", latency mean %.0f us, p50 < %u us, p99 < %u us, max %u us",
+               (double)l->SumUs / (double)n, p50, p99, l->MaxUs);
+    }
+    printf("\n");
+}
+
+static void report(void){
+    u32 i;
+
+    printf("dualpotd: %llu batches, %llu driver calls, %llu requests coalesced\n",
+           (unsigned long long)batches, (unsigned long long)submits, (unsigned long long)coalesced);
+    for(i = 0U; i < DAEMON_CLIENTS_MAX; i++){
+        if(client[i].Fd >= 0){
+            clientReport(&client[i]);
+        }
+    }
+    fflush(stdout);
+}
+
+static void clientClose(u32 Slot){
+    clientT *c = &client[Slot];
+
+    if(c->Fd < 0){
+        return;
+    }
+    printf("dualpotd: client left\n");
+    clientReport(c);
+    fflush(stdout);
+    (void)close(c->Fd);
+    c->Fd = -1;
+    c->Gen++;                               /* its waiters are answered nowhere */
+}
+
+static void clientAccept(int Listen){
+    struct ucred cred;
+    socklen_t len;
+    int fd;
+    u32 i;
+
+    while(0 <= (fd = accept4(Listen, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC))){
+        for(i = 0U; (i < DAEMON_CLIENTS_MAX) && (client[i].Fd >= 0); i++){
+        }
+        if(DAEMON_CLIENTS_MAX == i){
+            fprintf(stderr, "dualpotd: %u clients already, refused\n", DAEMON_CLIENTS_MAX);
+            (void)close(fd);
+            continue;
+        }
+        len = (socklen_t)sizeof(cred);
+        if((0 != getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len)) ||
+           ((geteuid() != cred.uid) && (0U != cred.uid))){
+            fprintf(stderr, "dualpotd: client of another user refused\n");
+            (void)close(fd);
+            continue;
+        }
+
+        client[i].Fd = fd;
+        client[i].Pid = cred.pid;
+        client[i].InLen = 0U;
+        client[i].OutLen = 0U;
+        memset(&client[i].Lat, 0, sizeof(client[i].Lat));
+    }
+}
+
+/* read what a client sent, queue every whole request */
+static void clientRead(u32 Slot, u64 RecvNs){
+    clientT *c = &client[Slot];
+    DualPotReqMsgT req;
+    ssize_t n;
+    u32 off;
+
+    for(;;){
+        n = recv(c->Fd, c->In + c->InLen, DAEMON_IN_BUF - c->InLen, 0);
+        if(n <= 0){
+            if((0 == n) || ((EAGAIN != errno) && (EWOULDBLOCK != errno) && (EINTR != errno))){
+                clientClose(Slot);
+            }
+            return;
+        }
+        c->InLen += (u32)n;
+
+        for(off = 0U; (off + sizeof(req)) <= c->InLen; off += (u32)sizeof(req)){
+            memcpy(&req, c->In + off, sizeof(req));
+            request(Slot, &req, RecvNs);
+            if(c->Fd < 0){
+                return;                     /* dropped while answering */
+            }
+        }
+        memmove(c->In, c->In + off, c->InLen - off);
+        c->InLen -= off;
+    }
+}
+
+/* warm restart state of the last run, False if there is none */
+static bool warmLoad(const char *Path, DualPotWarmT *Warm){
+    FILE *f = fopen(Path, "rb");
+    bool ok = False;
+
+    if(0 != f){
+        ok = (bool)(1U == fread(Warm, sizeof(*Warm), 1U, f));
+        (void)fclose(f);
+    }
+    return ok;
+}
+
+/* written beside and renamed over, a crash leaves the old state or none */
+static void warmSave(const char *Path, const DualPotWarmT *Warm){
+    char tmp[4096];
+    FILE *f;
+
+    (void)snprintf(tmp, sizeof(tmp), "%s.tmp", Path);
+    f = fopen(tmp, "wb");
+    if((0 == f) || (1U != fwrite(Warm, sizeof(*Warm), 1U, f)) || (0 != fflush(f)) ||
+       (0 != fsync(fileno(f)))){
+        perror(tmp);
+        if(0 != f){
+            (void)fclose(f);
+        }
+        (void)unlink(tmp);
+        return;
+    }
+    if((0 != fclose(f)) || (0 != rename(tmp, Path))){   /* on disk before it replaces the old state */
+        perror(Path);
+    }
+}
+
+/* remove the socket file at Path; nothing else is ever removed, and with
+   Own only the very socket this daemon bound */
+static bool sockRemove(const char *Path, const struct stat *Own){
+    struct stat st;
+
+    if(0 != lstat(Path, &st)){
+        return (bool)(ENOENT == errno);
+    }
+    if(!S_ISSOCK(st.st_mode)){
+        fprintf(stderr, "dualpotd: %s is not a socket, left alone\n", Path);
+        return False;
+    }
+    if((0 != Own) && ((Own->st_dev != st.st_dev) || (Own->st_ino != st.st_ino))){
+        return False;                       /* replaced by another daemon */
+    }
+    return (bool)(0 == unlink(Path));
+}
+
+/* bound with DUALPOT_SOCK_MODE from the start, Own is the socket file made */
+static int listenOn(const char *Path, struct stat *Own){
+    struct sockaddr_un addr;
+    mode_t mask;
+    int fd;
+    int rc;
+
+    if(strlen(Path) >= sizeof(addr.sun_path)){
+        fprintf(stderr, "dualpotd: socket path too long\n");
+        return -1;
+    }
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(fd < 0){
+        perror("socket");
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, Path);
+    if(0 == strncmp(Path, DUALPOT_SOCK_DIR "/", sizeof(DUALPOT_SOCK_DIR))){
+        (void)mkdir(DUALPOT_SOCK_DIR, 0700);    /* the default without $XDG_RUNTIME_DIR */
+    }
+    if(False == sockRemove(Path, 0)){       /* left over by an earlier run */
+        (void)close(fd);
+        return -1;
+    }
+    mask = umask((mode_t)(0777 & ~DUALPOT_SOCK_MODE));
+    rc = bind(fd, (const struct sockaddr *)&addr, sizeof(addr));
+    (void)umask(mask);
+    if((0 != rc) || (0 != lstat(Path, Own)) || (0 != listen(fd, 64))){
+        perror(Path);
+        (void)close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int main(int argc, char *argv[]) {
+    struct pollfd pfd[DAEMON_CLIENTS_MAX + 1U];
+    u32 slot[DAEMON_CLIENTS_MAX + 1U];
+    struct timespec period;
+    struct sigaction sa;
+    char defPath[sizeof(((struct sockaddr_un *)0)->sun_path) + 1U];
+    const char *path = DualPotSockPath(defPath, sizeof(defPath));
+    struct stat own;
+    const char *warmPath = 0;           /* -w, 0 for a cold start every time */
+    DualPotWarmT warm;
+    bool warmOk = False;
+    double reportS = 0.0;
+    u64 nextReport = 0U;
+    u64 now;
+#ifdef HAL_SIM
+    u64 simNs;
+    u64 ticks;
+#endif
+    nfds_t n;
+    bool moving;
+    int listenFd;
+    int opt;
+    u32 i;
+    u8 idx;
+
+    while(-1 != (opt = getopt(argc, argv, "s:r:w:"))){
+        switch(opt){
+        case 's':
+            path = optarg;
+            break;
+        case 'r':
+            reportS = atof(optarg);
+            break;
+        case 'w':
+            warmPath = optarg;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-s socket] [-r report seconds] [-w state file]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onSignal;
+    (void)sigaction(SIGINT, &sa, 0);
+    (void)sigaction(SIGTERM, &sa, 0);
+    (void)sigaction(SIGUSR1, &sa, 0);
+    for(i = 0U; i < DAEMON_CLIENTS_MAX; i++){
+        client[i].Fd = -1;
+    }
+
+    listenFd = listenOn(path, &own);
+    if(listenFd < 0){
+        return 1;
+    }
+    if((0 != warmPath) && (True == warmLoad(warmPath, &warm))){
+        warmOk = DualPotDrv_InitWarm(&warm);
+    }else{
+        DualPotDrv_Init();
+    }
+    DualPotDrv_SetDoneCallback(onDone);
+    printf("dualpotd: listening on %s, %s start\n", path, (True == warmOk) ? "warm" : "cold");
+    if(True == warmOk){
+        printf("dualpotd: taps %u %u from %s\n", warm.Tap[0], warm.Tap[1], warmPath);
+    }
+    fflush(stdout);
+
+    period.tv_sec = 0;
+    period.tv_nsec = DAEMON_POLL_NS;
+    now = nowNs();
+#ifdef HAL_SIM
+    simNs = now;
+#endif
+    if(reportS > 0.0){
+        nextReport = now + (u64)(reportS * 1e9);
+    }
+
+    while(0 == quit){
+        pfd[0].fd = listenFd;
+        pfd[0].events = POLLIN;
+        n = 1U;
+        for(i = 0U; i < DAEMON_CLIENTS_MAX; i++){
+            if(client[i].Fd >= 0){
+                pfd[n].fd = client[i].Fd;
+                pfd[n].events = (short)(POLLIN | ((0U != client[i].OutLen) ? POLLOUT : 0));
+                slot[n] = i;
+                n++;
+            }
+        }
+        moving = False;
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            moving = (bool)(moving || (True == chan[idx].Busy));
+        }
+
+        /* sleep until a client speaks, or one loop period while a move runs */
+        if((ppoll(pfd, n, (True == moving) ? &period : 0, 0) < 0) && (EINTR != errno)){
+            perror("ppoll");
+            break;
+        }
+        now = nowNs();
+
+        if(0 != (pfd[0].revents & POLLIN)){
+            clientAccept(listenFd);
+        }
+        for(i = 1U; i < n; i++){
+            if(0 != (pfd[i].revents & (POLLIN | POLLHUP | POLLERR))){
+                clientRead(slot[i], now);
+            }
+            if((client[slot[i]].Fd >= 0) && (0 != (pfd[i].revents & POLLOUT))){
+                clientFlush(slot[i]);
+            }
+        }
+
+        /* the batch of this pass, then the move under way */
+        submit();
+#ifdef HAL_SIM
+        ticks = (now - simNs) * (u64)TIMER_FREQ / 1000000000ULL;
+        simNs += ticks * 1000000000ULL / (u64)TIMER_FREQ;
+        if(False == moving){
+            ticks = 0U;                     /* the timer is stopped */
+        }
+        if(ticks > DAEMON_SIM_MAX){
+            ticks = DAEMON_SIM_MAX;
+        }
+        if(0U != ticks){
+            PeriodicSimRun((u32)ticks);
+        }
+#endif
+        DualPotDrv_Deferred();
+        recheck();
+
+        if((0 != reportDue) || ((0U != nextReport) && (now >= nextReport))){
+            reportDue = 0;
+            if(0U != nextReport){
+                nextReport = now + (u64)(reportS * 1e9);
+            }
+            report();
+        }
+    }
+
+    report();
+    for(i = 0U; i < DAEMON_CLIENTS_MAX; i++){
+        if(client[i].Fd >= 0){
+            (void)close(client[i].Fd);
+        }
+    }
+    (void)close(listenFd);
+    (void)sockRemove(path, &own);
+    if(0 != warmPath){
+        DualPotDrv_DeInitWarm(&warm);
+        warmSave(warmPath, &warm);
+    }else{
+        DualPotDrv_DeInit();
+    }
+    return 0;
+}
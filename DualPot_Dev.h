@@ -0,0 +1,96 @@
+/******************************************************************************/
+//	DualPot_Dev.h
+/******************************************************************************/
+
+#ifndef MOTIV_DUALPOT_DEV_H
+#define MOTIV_DUALPOT_DEV_H
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include "DualPot_Drv.h"
+#include "Sync.h"
+
+/******************************************************************************/
+//	macros
+/******************************************************************************/
+
+/* performance counter update, compiled out with DUALPOT_STATS 0 */
+#if DUALPOT_STATS
+#define DUALPOT_STAT(update) update
+#else
+#define DUALPOT_STAT(update)
+#endif
+
+/* ISR profiler update, compiled out with DUALPOT_PROFILE 0 */
+#if DUALPOT_PROFILE
+#define DUALPOT_PROF(update) update
+#else
+#define DUALPOT_PROF(update)
+#endif
+
+/******************************************************************************/
+//	types
+/******************************************************************************/
+
+/* Device operations behind DualPotDrv_Init/Main/DeInit/Deferred/EstimateSettle,
+ * DualPotDrv_TrajStart/TrajQueue/TrajStop and DualPotDrv_Resync.
+ * Init takes a checked warm restart state or 0 for a cold start; DeInit
+ * fills Tap, Up and Pulses of one, or exports nothing for 0.
+ * Main gets a range checked channel (chA/chB), tap and deadline in ticks
+ * from now (0 for none, devices without a timer ignore it), and returns True
+ * once no channel is moving any more; devices that set the tap in a
+ * single transaction return True right away */
+typedef struct {
+    void (*Init)(const DualPotWarmT *warm);
+                                        /* bring up the device and its HAL modules */
+    bool (*Main)(u8 channel, u8 tap, u32 deadline);
+                                        /* request a tap, poll for completion */
+    void (*DeInit)(DualPotWarmT *warm); /* stop, release the device inputs */
+    void (*Deferred)(void);             /* bottom half work left by the ISR */
+    void (*Settle)(u8 channel, const f32 *resistance, DualPotSettleT *settle, size_t n);
+                                        /* Ticks of each move of a range checked sequence */
+    bool (*TrajStart)(u8 channel);      /* enter trajectory mode, False if not supported */
+    size_t (*TrajQueue)(u8 channel, const u8 *tap, const u32 *ticks, size_t n);
+                                        /* queue points into free chunks, returns points taken */
+    void (*TrajStop)(u8 channel);       /* leave trajectory mode, the last move completes */
+    bool (*Resync)(u8 channel);         /* re-establish the wiper position, go on to the tap
+                                         * last requested; True once started */
+} DualPotDevT;
+
+/******************************************************************************/
+//	variables
+/******************************************************************************/
+extern const DualPotDevT DualPotDev_Max5389;    /* up/down protocol, DualPot_Max5389.c */
+extern const DualPotDevT DualPotDev_Spi;        /* SPI programmed wiper, DualPot_Spi.c */
+
+/* performance counters, static RAM or the shared memory region (DualPot_Stats.c) */
+extern SyncLocal DualPotStatsT *DualPotStats;
+
+/******************************************************************************/
+//	service functions
+/******************************************************************************/
+
+/* completion of a move, calls the DualPotDrv_SetDoneCallback callback (DualPot_Drv.c) */
+void DualPotDone_Notify(u8 channel, u8 tap);
+
+/* ask the trajectory producer of channel for the next chunk and queue it,
+ * returns the points queued (DualPot_Drv.c) */
+size_t DualPotTraj_Refill(u8 channel);
+
+/* place the performance counters, called by DualPotDrv_Init */
+void DualPotStats_Attach(void);
+
+/* take them back to RAM, called by DualPotDrv_DeInit */
+void DualPotStats_Detach(void);
+
+/* add one ISR run to the histograms, DUALPOT_PROFILE builds only */
+void DualPotProfile_Record(u8 branches, u8 moving, u32 cycles);
+
+/* Status publication for DualPotDrv_GetStatus (DualPot_Status.c).
+ * One writer at a time, the ISR while the timer runs: fill the returned
+ * snapshot between the two calls */
+DualPotStatusT *DualPotStatus_WriteBegin(void);
+void DualPotStatus_WriteEnd(void);
+
+#endif //MOTIV_DUALPOT_DEV_H
@@ -4,57 +4,72 @@
 * PUBLIC FUNCTIONS :
 *           void DualPotDrv_Init(void)
 *           bool DualPotDrv_Main(u8 channel ,f32 resistance)
+*           bool DualPotDrv_MainDeadline(u8 channel, f32 resistance, u32 deadline)
+*           bool DualPotDrv_MainTap(u8 channel, u8 tap, u32 deadline)
 *           void DualPotDrv_DeInit(void)
-* NOTES : This application driver means to control
-*         a dual-channel digital potentiometer (MAX5389, 10 kΩ model)
+*           bool DualPotDrv_InitWarm(const DualPotWarmT *warm)
+*           void DualPotDrv_DeInitWarm(DualPotWarmT *warm)
+*           void DualPotDrv_Deferred(void)
+*           void DualPotDrv_SetDoneCallback(DualPotDoneCbT cb)
+*           bool DualPotDrv_TrajStart(u8 channel, DualPotTrajFillCbT fill)
+*           size_t DualPotDrv_TrajQueue(u8 channel, const DualPotPointT *point, size_t n)
+*           void DualPotDrv_TrajStop(u8 channel)
+*           bool DualPotDrv_Resync(u8 channel)
+*           bool DualPotDrv_EstimateSettle(u8 channel, f32 resistance, DualPotSettleT *settle)
+*           size_t DualPotDrv_EstimateSettleBatch(u8 channel, const f32 *resistance,
+*                                                 DualPotSettleT *settle, size_t n)
+* NOTES : Range checks requests, converts resistance to a tap value and
+*         hands it to the device selected with DUALPOT_DEVICE
+*         (MAX5389 up/down protocol or SPI programmed wiper)
 * AUTHOR : Sarika Natu         DATE : 22 Jun 2020
 * CHANGES :
 * VERSION   DATE      WHO     DETAIL
 * 0.1.0   19Jun2020   SN      Dual pot driver implementation
 * 0.2.0   21Jun2020   SN      Multichannel support
+* 0.4.0   18Oct2026   agent   Device abstraction, MAX5389 state machine moved
+*                             to DualPot_Max5389.c
+* 0.5.0   18Oct2026   agent   Accepted/rejected request counters
+* 0.6.0   18Oct2026   agent   Bottom half entry and completion callback
+* 0.7.0   18Oct2026   agent   Settle time estimation
+* 0.8.0   18Oct2026   agent   Requests with a deadline
+* 0.9.0   18Oct2026   agent   Trajectory mode
+* 0.9.1   18Oct2026   agent   Thread local state for the fleet simulation
+* 0.9.2   18Oct2026   agent   Requests by tap, for taps converted at build time
+* 0.9.3   18Oct2026   agent   Wiper resync through an end stop
+* 0.9.4   18Oct2026   agent   Warm restart from exported channel state
+* 0.9.5   18Oct2026   agent   Performance counters detached at DeInit
 *H***********************************************************************/
 
 /******************************************************************************/
 //	includes
 /******************************************************************************/
-#include "DualPot_Drv.h"
+#include "DualPot_Dev.h"
 
 /******************************************************************************
  *	variables
  ******************************************************************************/
-typedef enum {
-    Initial = 0,            /* Initial state */
-    Setup1,                 /* Setup1 State */
-    Setup2,                 /* Setup2 State */
-    Running,                /* Running State */
-    Stop                    /* Done State */
-} Sig_states;
-
-#pragma pack(push, 1)
-struct DigiPot{
-    u8 channel:8;               /* Channel indication */
-    u8 curr_Tap:8;              /* store current Wiper tap value */
-    u8 tapVal:8;                /* store required output Wiper tap value*/
-    bool cs:1;                  /* chip select input */
-    bool updwn_ctrl:1;          /* up/down control input */
-    bool MoveDownFlag:1;        /* move down notification */
-    bool MoveUpFlag:1;          /* move up notification */
-    Sig_states STATE;           /* state indication */
-}channelA,channelB;
-#pragma pack(pop)
-
-bool prevIncr;            /* variable to store previous value increment control input*/
-bool incr_ctrl;           /* Wiper increment control input*/
-bool updwn50usFlag;       /* Control 50us timer elapse*/
+#if (DUALPOT_DEVICE == DUALPOT_DEVICE_MAX5389)
+#define DEV (&DualPotDev_Max5389)
+#elif (DUALPOT_DEVICE == DUALPOT_DEVICE_SPI)
+#define DEV (&DualPotDev_Spi)
+#else
+#error "DUALPOT_DEVICE: unsupported potentiometer device"
+#endif
+
+static SyncLocal DualPotDoneCbT doneCb = 0; /* completion callback, 0 if none */
+static SyncLocal DualPotTrajFillCbT trajFill[DUALPOT_CH_QUAN]; /* trajectory producer per channel, 0 if none */
 
 /******************************************************************************
  *	local functions
  ******************************************************************************/
 static u8 getTap(f32 resistance);
-static void setWiper(void);
-static void generateSig(void);
+static bool inRange(u8 channel, f32 resistance);
+static u32 warmCheck(const DualPotWarmT *warm);
 
-void ISR_Timer25us_Handler(void);
+/******************************************************************************
+ *	local macros
+ ******************************************************************************/
+#define TICK_US     ((f32)1000000 / TIMER_FREQ)     /* timer period in microseconds */
 
 /********************************************************************
 * FUNCTION   : void DualPotDrv_Init(void)
@@ -63,49 +78,9 @@ void ISR_Timer25us_Handler(void);
 * RETURN     : void
 **********************************************************************/
 void DualPotDrv_Init(void){
-    PeriodicModuleInit();       /* Initialize periodic module */
-    PeriodicIruptDisable();     /* Disabling interrupts */
-
-    PinModuleInit();            /* Initialize pin module */
-
-    if(TIMER_FREQ <= PeriodicFreqHzMax){    /* check if required rolling frequency is in range */
-        /* Setting rolling frequency and assign interrupt handler*/
-        PeriodicConfig(TIMER_FREQ, ISR_Timer25us_Handler);
-    }
-
-    /* Initialize tap value to 128 at power-up for Channel A and Channel B */
-    channelA.curr_Tap = MID_TAP;
-    channelB.curr_Tap = MID_TAP;
-
-    /* Initialize move up and move down flags for Channel A and Channel B */
-    channelA.MoveUpFlag = False;
-    channelA.MoveDownFlag = False;
-    channelB.MoveUpFlag = False;
-    channelB.MoveDownFlag = False;
-
-    /* Initialize signal state for Channel A and Channel B */
-    channelA.STATE = Initial;
-    channelB.STATE = Initial;
-
-    /* Initialize 50us timer flag */
-    updwn50usFlag = False;
-
-    /* Initialize chip select for Channel A and Channel B; write to the respective registers */
-    channelA.cs = True;
-    channelB.cs = True;
-    PinWrite(PinCSA, channelA.cs);
-    PinWrite(PinCSB, channelB.cs);
-
-    /* Initialize Up/Down control signal for Channel A and Channel B  */
-    channelA.updwn_ctrl = False;
-    channelB.updwn_ctrl = False;
-
-    /* Initialize increment control signal */
-    prevIncr = True;                     /* Initialize previous increment value */
-    incr_ctrl = True;                    /* Initialize increment control variable */
-
-    PeriodicIruptEnable();                /* Enabling interrupts */
 
+    DualPotStats_Attach();
+    DEV->Init(0);
 }
 
 /********************************************************************
@@ -117,70 +92,56 @@ void DualPotDrv_Init(void){
 **********************************************************************/
 bool DualPotDrv_Main(u8 channel,f32 resistance) {
 
-    bool retVal = False;                    /* return value */
+    return DualPotDrv_MainDeadline(channel, resistance, 0U);
+}
 
-    /* Checking if resistance and requested channel is in range */
-    if((resistance >= MIN_RESISTANCE) && (resistance <= MAX_RESISTANCE) && ((chA == channel) || (chB == channel))){
-        if(chA == channel){
-            channelA.channel = chA;
-            channelA.tapVal = getTap(resistance);   /* Get tap value for the provided resistance for channel A */
-        }
-        if (chB == channel){
-            channelB.channel = chB;
-            channelB.tapVal = getTap(resistance);   /* Get tap value for the provided resistance for channel B */
-        }
+/********************************************************************
+* FUNCTION   : bool DualPotDrv_MainDeadline(u8 channel, f32 resistance, u32 deadline)
+* PURPOSE    : DualPotDrv_Main for a move due within deadline ticks
+* PARAMETERS : u8 channel           //channel for resistance setting
+*              f32 resistance       //desired value of the resistance
+*              u32 deadline         //timer ticks from now the move is due in, 0 for none
+* RETURN     : bool
+* NOTE       : the deadline is taken when the target changes; repeated
+*              polls for the same target keep the one of the first request
+**********************************************************************/
+bool DualPotDrv_MainDeadline(u8 channel, f32 resistance, u32 deadline) {
 
-        setWiper();                           /* Move towards desired wiper location if conditions are met */
-
-        /* Check digital resistive value is nearer to LA or HA for channel A.
-         * set move up or move down flag accordingly if channel A is requested */
-        if (chA == channelA.channel){
-            if(channelA.tapVal <= MID_TAP){
-                channelA.MoveDownFlag = True;
-            }else {
-                if(channelA.tapVal > MID_TAP){
-                    channelA.MoveUpFlag = True;
-                }/*ELSE: Do nothing*/
-            }
-        }
+    bool retVal = False;                    /* return value */
 
-        /* Check digital resistive value is nearer to LB or HB for channel B
-         * set move up or move down flag accordingly if channel B is requested */
-        if (chB == channelB.channel){
-            if(channelB.tapVal <= MID_TAP){
-                channelB.MoveDownFlag = True;
-            }else {
-                if(channelB.tapVal > MID_TAP){
-                    channelB.MoveUpFlag = True;
-                }/*ELSE: Do nothing*/
-            }
+    /* Checking if resistance and requested channel is in range */
+    if(True == inRange(channel, resistance)){
+        DUALPOT_STAT(DualPotStats->Ch[channel - chA].Accepted++);
+        retVal = DEV->Main(channel, getTap(resistance), deadline);
+    } else{
+        if((chA == channel) || (chB == channel)){
+            DUALPOT_STAT(DualPotStats->Ch[channel - chA].Rejected++);
+        }else{
+            DUALPOT_STAT(DualPotStats->RejectedChannel++);
         }
+        retVal = False;
+    }
+    return retVal;
+}
 
-        //printf("\n Size of Structure channelA = %lu\n\n",sizeof(channelA));
-
-        generateSig();                            /* setting initial inputs to control wiper terminal(WA/WB) */
-
-        /* if desired tap value is achieved return success else fail */
-        if(channelA.tapVal == channelA.curr_Tap) {
-            channelA.MoveDownFlag = False;          /* reset move up or move down flag for channel A */
-            channelA.MoveUpFlag = False;
-            channelA.STATE = Stop;                  /* change signal state to Stop for channel A */
-        }
-        if(channelB.tapVal == channelB.curr_Tap){
+/********************************************************************
+* FUNCTION   : bool DualPotDrv_MainTap(u8 channel, u8 tap, u32 deadline)
+* PURPOSE    : DualPotDrv_MainDeadline for a tap converted by the caller
+* PARAMETERS : u8 channel           //channel for resistance setting
+*              u8 tap               //desired tap, DUALPOT_TAP of the resistance
+*              u32 deadline         //timer ticks from now the move is due in, 0 for none
+* RETURN     : bool
+* NOTE       : every tap is in range, only the channel is checked
+**********************************************************************/
+bool DualPotDrv_MainTap(u8 channel, u8 tap, u32 deadline) {
 
-            channelB.MoveDownFlag = False;          /* reset move up or move down flag for channel B */
-            channelB.MoveUpFlag = False;
-            channelB.STATE = Stop;                  /* change signal state to Stop for channel B */
-        }
+    bool retVal = False;                    /* return value */
 
-        /* If no channel is running, stop the timer and return successful */
-        if(((Stop == channelA.STATE) && (Initial == channelB.STATE)) ||
-           ((Initial == channelA.STATE) && (Stop == channelB.STATE)) ||
-           ((Stop == channelA.STATE) && (Stop == channelB.STATE))){
-            PeriodicStop();                         /* timer stop */
-            retVal = True;
-        }
+    if((chA == channel) || (chB == channel)){
+        DUALPOT_STAT(DualPotStats->Ch[channel - chA].Accepted++);
+        retVal = DEV->Main(channel, tap, deadline);
     } else{
+        DUALPOT_STAT(DualPotStats->RejectedChannel++);
         retVal = False;
     }
     return retVal;
@@ -194,243 +155,302 @@ bool DualPotDrv_Main(u8 channel,f32 resistance) {
 **********************************************************************/
 void DualPotDrv_DeInit(void){
 
-    //printf("Requested tap value for %d channel is %d!\n", channelA.channel, channelA.tapVal); /* for testing purpose */
-    //printf("Requested tap value for %d channel is %d!\n", channelB.channel, channelB.tapVal); /* for testing purpose */
+    DEV->DeInit(0);
+    DualPotStats_Detach();
+}
+
+/********************************************************************
+* FUNCTION   : bool DualPotDrv_InitWarm(const DualPotWarmT *warm)
+* PURPOSE    : Initialize DualPot Driver from the state of a previous run
+* PARAMETERS : const DualPotWarmT *warm //state from DualPotDrv_DeInitWarm, 0 if none
+* RETURN     : bool                 //True if the state was taken, else the
+*                                   //driver started cold as DualPotDrv_Init
+* NOTE       : only valid if the pots stayed powered since the export
+**********************************************************************/
+bool DualPotDrv_InitWarm(const DualPotWarmT *warm){
 
-    /* Reset chip select for Channel A and Channel B by writing to the respective registers */
-    PinWrite(PinCSA, True);
-    PinWrite(PinCSB, True);
+    bool retVal = False;                    /* return value */
 
-    /* Reset Up/Down control signal for Channel A and Channel B by writing to the respective registers */
-    PinWrite(PinUDA, False);
-    PinWrite(PinUDB, False);
+    if((0 != warm) && (DUALPOT_WARM_MAGIC == warm->Magic) && (DUALPOT_WARM_VERSION == warm->Version) &&
+       (DUALPOT_DEVICE == warm->Device) && (DUALPOT_CH_QUAN == warm->ChQuan) &&
+       (warmCheck(warm) == warm->Check)){
+        retVal = True;
+    }/*ELSE: Do nothing, cold start*/
 
-    /* Reset Increment control signal for Channel A and Channel B by writing to the respective registers */
-    PinWrite(PinINCA, True);
-    PinWrite(PinINCB, True);
+    DualPotStats_Attach();
+    DEV->Init((True == retVal) ? warm : 0);
+    return retVal;
 }
 
 /********************************************************************
-* FUNCTION   : u8 getTap(f32 resistance)
-* PURPOSE    : Calculate tap value for desired resistance
-* PARAMETERS : f32 resistance       //desired value of the resistance
-* RETURN     : u8
+* FUNCTION   : void DualPotDrv_DeInitWarm(DualPotWarmT *warm)
+* PURPOSE    : De-initialize DualPot Driver, export the channel state
+* PARAMETERS : DualPotWarmT *warm   //filled for DualPotDrv_InitWarm
+* RETURN     : void
+* NOTE       : a move under way stops at the tap it reached
 **********************************************************************/
-u8 getTap(f32 resistance) {
+void DualPotDrv_DeInitWarm(DualPotWarmT *warm){
+    u8 idx;
+
+    if(0 != warm){
+        warm->Magic = DUALPOT_WARM_MAGIC;
+        warm->Version = (u8)DUALPOT_WARM_VERSION;
+        warm->Device = (u8)DUALPOT_DEVICE;
+        warm->ChQuan = (u8)DUALPOT_CH_QUAN;
+        warm->Reserved = 0U;
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            warm->Tap[idx] = MID_TAP;
+            warm->Up[idx] = 0U;
+            warm->Pulses[idx] = 0U;
+        }
+    }/*ELSE: Do nothing*/
 
-    /* return tap value for the provided  input resistance */
-    return (u8)(resistance/MAX_RESISTANCE * FULL_TAP);
+    DEV->DeInit(warm);
+    DualPotStats_Detach();
+
+    if(0 != warm){
+        warm->Check = warmCheck(warm);
+    }/*ELSE: Do nothing*/
 }
 
 /********************************************************************
-* FUNCTION   : static void setWiper(void)
-* PURPOSE    : Calculate tap value for desired resistance
+* FUNCTION   : void DualPotDrv_Deferred(void)
+* PURPOSE    : Run the bottom half of the device
 * PARAMETERS : void
 * RETURN     : void
 **********************************************************************/
-static void setWiper(void){
-
-    /* Check if the signal state is Running for Channel A */
-    if(Running == channelA.STATE){
+void DualPotDrv_Deferred(void){
 
-        /* Check for falling edge on increment control signal for Channel A */
-        if((True == prevIncr) && (False == incr_ctrl)){
-
-            //printf("Current tap value for %d channel is %d!\n", channelA.channel, channelA.curr_Tap); /* for testing purpose */
+    DEV->Deferred();
+}
 
-            /* Check if the move down flag is true and if wiper terminal has not reached its minimum value*/
-            if((True == channelA.MoveDownFlag) && (MIN_TAP != channelA.curr_Tap)){
+/********************************************************************
+* FUNCTION   : bool DualPotDrv_TrajStart(u8 channel, DualPotTrajFillCbT fill)
+* PURPOSE    : Hand the channel over to the timer, to play timed setpoints
+* PARAMETERS : u8 channel           //channel to play the trajectory on
+*              DualPotTrajFillCbT fill  //producer called for each free chunk, 0 if
+*                                   //points are only queued with DualPotDrv_TrajQueue
+* RETURN     : bool                 //False for an unknown channel or a device without timer
+* NOTE       : the trajectory ends when the last queued point has been held for
+*              its Ticks and no more points follow; the completion callback
+*              reports the tap it ends at
+**********************************************************************/
+bool DualPotDrv_TrajStart(u8 channel, DualPotTrajFillCbT fill){
 
-                /* decrementing the tap value by one position
-                * as wiper terminal should be moved one tap location towards low terminal */
-                channelA.curr_Tap--;
+    bool retVal = False;                    /* return value */
 
-            }else {
-                /* Check if the move up flag is true and if wiper terminal has not reached its maximum value*/
-                if((True == channelA.MoveUpFlag) && (FULL_TAP != channelA.curr_Tap)){
+    if((chA == channel) || (chB == channel)){
+        trajFill[channel - chA] = fill;
+        retVal = DEV->TrajStart(channel);
+        if(True == retVal){
+            DEV->Deferred();                /* first chunks from the producer */
+        }/*ELSE: Do nothing*/
+    }/*ELSE: Do nothing*/
+    return retVal;
+}
 
-                    /* incrementing the tap value by one position
-                    * as wiper terminal should be moved one tap location towards high terminal */
-                    channelA.curr_Tap++;
-                }/*ELSE: Do nothing*/
-            }
+/********************************************************************
+* FUNCTION   : size_t DualPotDrv_TrajQueue(u8 channel, const DualPotPointT *point, size_t n)
+* PURPOSE    : Queue trajectory points behind the ones playing
+* PARAMETERS : u8 channel           //channel in trajectory mode
+*              const DualPotPointT *point   //points, played in order
+*              size_t n             //number of points
+* RETURN     : size_t               //points queued; stops at a full queue or
+*                                   //the first point failing the range check
+**********************************************************************/
+size_t DualPotDrv_TrajQueue(u8 channel, const DualPotPointT *point, size_t n){
+    u8 tap[DUALPOT_TRAJ_CHUNK];
+    u32 ticks[DUALPOT_TRAJ_CHUNK];
+    size_t done = 0U;                       /* points queued */
+    size_t quan;                            /* points converted for the next chunk */
+    size_t taken = 1U;                      /* points the device took of them */
+
+    while((0 != point) && (done < n) && (0U != taken)){
+        quan = 0U;
+        while((quan < DUALPOT_TRAJ_CHUNK) && ((done + quan) < n) &&
+              (True == inRange(channel, point[done + quan].Resistance))){
+            tap[quan] = getTap(point[done + quan].Resistance);
+            ticks[quan] = point[done + quan].Ticks;
+            quan++;
+        }
+        if(0U != quan){
+            taken = DEV->TrajQueue(channel, tap, ticks, quan);
+        }else{
+            taken = 0U;                     /* point out of range */
+        }
+        done += taken;
+        if(taken < quan){
+            taken = 0U;                     /* queue full */
         }
     }
+    return done;
+}
 
-    /* Check if the signal state is Running for Channel A */
-    if(channelB.STATE == Running){
-
-        /* Check for falling edge on increment control signal for Channel B */
-        if((True == prevIncr) && (False == incr_ctrl)){
-
-            //printf("Current tap value for %d channel is %d!\n", channelB.channel, channelB.curr_Tap); /* for testing purpose */
+/********************************************************************
+* FUNCTION   : void DualPotDrv_TrajStop(u8 channel)
+* PURPOSE    : End trajectory mode, the move under way completes
+* PARAMETERS : u8 channel           //channel in trajectory mode
+* RETURN     : void
+**********************************************************************/
+void DualPotDrv_TrajStop(u8 channel){
 
-            /* Check if the move down flag is true and if wiper terminal has not reached its minimum value*/
-            if((True == channelB.MoveDownFlag) && (MIN_TAP != channelB.curr_Tap)){
+    if((chA == channel) || (chB == channel)){
+        DEV->TrajStop(channel);
+        trajFill[channel - chA] = 0;
+    }/*ELSE: Do nothing*/
+}
 
-                /* decrementing the tap value by one position
-                * as wiper terminal should be moved one tap location towards low terminal */
-                channelB.curr_Tap--;
+/********************************************************************
+* FUNCTION   : bool DualPotDrv_Resync(u8 channel)
+* PURPOSE    : Re-establish the wiper position of a channel
+* PARAMETERS : u8 channel           //channel to resync
+* RETURN     : bool                 //False for an unknown channel
+* NOTE       : for a wiper that missed pulses or a part reset; the channel
+*              then goes on to the tap last requested, poll with that
+*              request or wait for the completion callback
+**********************************************************************/
+bool DualPotDrv_Resync(u8 channel){
 
-            }else {
-                /* Check if the move up flag is true and if wiper terminal has not reached its maximum value*/
-                if((True == channelB.MoveUpFlag) && (FULL_TAP != channelB.curr_Tap)){
+    bool retVal = False;                    /* return value */
 
-                    /* incrementing the tap value by one position
-                    * as wiper terminal should be moved one tap location towards high terminal */
-                    channelB.curr_Tap++;
-                }/*ELSE: Do nothing*/
-            }
-        }
+    if((chA == channel) || (chB == channel)){
+        retVal = DEV->Resync(channel);
+    } else{
+        DUALPOT_STAT(DualPotStats->RejectedChannel++);
     }
-    prevIncr = incr_ctrl;               /* storing current increment control value */
+    return retVal;
 }
 
 /********************************************************************
-* FUNCTION   : void generateSig(void)
-* PURPOSE    : Calculate tap value for desired resistance
-* PARAMETERS : void
-* RETURN     : void
+* FUNCTION   : size_t DualPotTraj_Refill(u8 channel)
+* PURPOSE    : Queue the next chunk of the trajectory producer
+* PARAMETERS : u8 channel           //channel in trajectory mode
+* RETURN     : size_t               //points queued, 0 if there is no producer
+*                                   //or it has no more points
+* NOTE       : called by the bottom half of the device for each free chunk;
+*              points failing the range check end the chunk early
 **********************************************************************/
-static void generateSig(void) {
-
-    /* timer start flag to avoid PeriodicStart() function call more than once */
-    static bool timer_start = False;
-
-    /* Check if channel A is in initial signal state */
-    if((chA == channelA.channel) && (Initial == channelA.STATE)){
-
-        /* Update Up/Down flag according to Move up and Move down flags */
-        if(True == channelA.MoveDownFlag){
-            channelA.updwn_ctrl = False;                    /* setting Up/Down control signal as down */
-        } else {
-            if(True == channelA.MoveUpFlag){
-                channelA.updwn_ctrl = True;                 /* setting Up/Down control signal as Up */
-            }/*ELSE: Do nothing*/
+size_t DualPotTraj_Refill(u8 channel){
+    DualPotPointT point[DUALPOT_TRAJ_CHUNK];
+    DualPotTrajFillCbT fill = trajFill[channel - chA];
+    size_t quan = 0U;                       /* points produced */
+
+    if(0 != fill){
+        quan = fill(channel, point, DUALPOT_TRAJ_CHUNK);
+        if(quan > DUALPOT_TRAJ_CHUNK){
+            quan = DUALPOT_TRAJ_CHUNK;
         }
+        quan = DualPotDrv_TrajQueue(channel, point, quan);
+    }/*ELSE: Do nothing*/
+    return quan;
+}
 
-        incr_ctrl = True;                                   /* setting increment control signal to high for channel A */
-        PinWrite(PinUDA, channelA.updwn_ctrl);
-        PinWrite(PinINCA, incr_ctrl);
-        channelA.STATE = Setup1;                            /* change signal state to Setup1 for channel A */
+/********************************************************************
+* FUNCTION   : bool DualPotDrv_EstimateSettle(u8 channel, f32 resistance, DualPotSettleT *settle)
+* PURPOSE    : Time a request would take from the current state
+* PARAMETERS : u8 channel           //channel for resistance setting
+*              f32 resistance       //desired value of the resistance
+*              DualPotSettleT *settle   //ticks and microseconds until the channel stops
+* RETURN     : bool                 //False if the request fails the range check
+**********************************************************************/
+bool DualPotDrv_EstimateSettle(u8 channel, f32 resistance, DualPotSettleT *settle){
 
-    }
+    return (bool)(1U == DualPotDrv_EstimateSettleBatch(channel, &resistance, settle, 1U));
+}
 
-    /* Check if channel B is in initial signal state */
-    if((chB == channelB.channel) && (Initial == channelB.STATE)){
+/********************************************************************
+* FUNCTION   : size_t DualPotDrv_EstimateSettleBatch(u8 channel, const f32 *resistance,
+*                                                     DualPotSettleT *settle, size_t n)
+* PURPOSE    : Time each move of a setpoint sequence
+* PARAMETERS : u8 channel           //channel for resistance setting
+*              const f32 *resistance    //setpoints, requested in order
+*              DualPotSettleT *settle   //per setpoint, ticks and microseconds of its move
+*              size_t n             //number of setpoints
+* RETURN     : size_t               //setpoints estimated, stops at the first failing the range check
+* NOTE       : each setpoint is taken as requested as soon as the previous one stopped
+**********************************************************************/
+size_t DualPotDrv_EstimateSettleBatch(u8 channel, const f32 *resistance, DualPotSettleT *settle, size_t n){
+    size_t valid = 0U;                      /* setpoints passing the range check */
+    size_t i;
 
-        /* Update Up/Down control signal according to Move up and Move down flags */
-        if(True == channelB.MoveDownFlag){
-            channelB.updwn_ctrl = False;                     /* setting Up/Down control signal as down */
-        } else {
-            if(True == channelB.MoveUpFlag){
-                channelB.updwn_ctrl = True;                  /* setting Up/Down control signal as Up */
-            }/*ELSE: Do nothing*/
+    if((0 != resistance) && (0 != settle)){
+        while((valid < n) && (True == inRange(channel, resistance[valid]))){
+            valid++;
         }
-
-        incr_ctrl = True;                                   /* setting increment control signal to high for channel B */
-        PinWrite(PinUDB, channelB.updwn_ctrl);
-        PinWrite(PinINCB, incr_ctrl);
-        channelB.STATE = Setup1;                            /* change signal state to Setup1 for channel B */
     }
 
-    /* Start the timer if timer is not already running and if signal state of either channel is Setup1 */
-    if((Setup1 == channelA.STATE) && (False == timer_start)){
-        PeriodicStart();
-        timer_start = True;
-    }else{
-        if((Setup1 == channelB.STATE) && (False == timer_start)){
-            PeriodicStart();
-            timer_start = True;
+    if(0U != valid){
+        DEV->Settle(channel, resistance, settle, valid);
+        for(i = 0U; i < valid; i++){
+            settle[i].Us = (f32)settle[i].Ticks * TICK_US;
         }
     }
-
+    return valid;
 }
 
 /********************************************************************
-* FUNCTION   : void ISR_Timer25us_Handler(void)
-* PURPOSE    : ISR
-* PARAMETERS : void
+* FUNCTION   : void DualPotDrv_SetDoneCallback(DualPotDoneCbT cb)
+* PURPOSE    : Register the completion callback
+* PARAMETERS : DualPotDoneCbT cb    //called from the bottom half, 0 to remove
 * RETURN     : void
 **********************************************************************/
-void ISR_Timer25us_Handler(void){
-
-    /* Check if either of channel A or channel B is active */
-    if((chA == channelA.channel) || (chB == channelB.channel)){
-
-        /* If ISR is hit for the first time UpDown control signal will not be set as it needs 50us time*/
-        if(True == updwn50usFlag){
-
-            updwn50usFlag = False;                      /* reset 50us timer flag for 50us completion*/
-
-            /* Check if channel A is in Setup1 signal state */
-            if((chA == channelA.channel) && (Setup1 == channelA.STATE)){
-
-                /* Update Up/Down control signal according to Move up and Move down flags */
-                if(True == channelA.MoveDownFlag){
-                    channelA.updwn_ctrl = False;            /* Clear Up/Down control signal */
-                }else{
-                    if(True == channelA.MoveUpFlag) {
-                        channelA.updwn_ctrl = True;         /* Set Up/Down control signal */
-                    }/*ELSE: Do nothing*/
-                }
-                PinWrite(PinUDA, channelA.updwn_ctrl);
-                channelA.STATE = Setup2;                    /* change signal state to Setup2 for channel A */
-
-            }
-
-            /* Check if channel B is in Setup1 signal state */
-            if((chB == channelB.channel) && (Setup1 == channelB.STATE)){
-
-                /* Update Up/Down control signal according to Move up and Move down flags */
-                if(True == channelB.MoveDownFlag){
-                    channelB.updwn_ctrl = False;             /* Clear Up/Down control signal */
-                }else {
-                    if(True == channelB.MoveUpFlag){
-                        channelB.updwn_ctrl = True;          /* Set Up/Down control signal */
-                    }/*ELSE: Do nothing*/
-                }
-                PinWrite(PinUDB, channelB.updwn_ctrl);
-                channelB.STATE = Setup2;                    /* change signal state to Setup2 for channel B */
-            }
-        }else{
+void DualPotDrv_SetDoneCallback(DualPotDoneCbT cb){
 
-            /* setting chip select of respective channel to low if signal state is Setup1 */
-            if((chA == channelA.channel)&& (Setup1 == channelA.STATE)){
-                channelA.cs = False;
-                PinWrite(PinCSA, channelA.cs);
-            }
-            if((chB == channelB.channel)&& (Setup1 == channelB.STATE)){
-                channelB.cs = False;
-                PinWrite(PinCSB, channelB.cs);
-            }
-
-            updwn50usFlag = True;                           /* setting 50us flag for 25us completion*/
-        }
+    doneCb = cb;
+}
 
-        /* Inverting the Increment control signal every 25us if channels are in Setup2/Running signal state */
-        if((Setup2 == channelA.STATE) || (Setup2 == channelB.STATE) ||
-           (Running == channelA.STATE) || (Running == channelB.STATE)){
-            incr_ctrl = (bool) !incr_ctrl;
-
-            /* Store increment control value if its TRUE for detecting falling edge */
-            if(True == incr_ctrl){
-                prevIncr = True;
-            }
-
-            /* Writing increment control signal values to respective pins*/
-            if((chA == channelA.channel) && (Stop != channelA.STATE)){
-                PinWrite(PinINCA, incr_ctrl);
-                channelA.STATE = Running;
-            }
-            if((chB == channelB.channel) && (Stop != channelB.STATE)){
-                PinWrite(PinINCB, incr_ctrl);
-                channelB.STATE = Running;
-            }/*ELSE: Do nothing*/
-        }
+/********************************************************************
+* FUNCTION   : void DualPotDone_Notify(u8 channel, u8 tap)
+* PURPOSE    : Report a completed move to the callback
+* PARAMETERS : u8 channel           //channel that stopped
+*              u8 tap               //tap it stopped at
+* RETURN     : void
+**********************************************************************/
+void DualPotDone_Notify(u8 channel, u8 tap){
+
+    if(0 != doneCb){
+        doneCb(channel, tap);
     }
+}
+
+/********************************************************************
+* FUNCTION   : bool inRange(u8 channel, f32 resistance)
+* PURPOSE    : Range check of a request
+* PARAMETERS : u8 channel           //requested channel
+*              f32 resistance       //requested resistance
+* RETURN     : bool                 //True if both are in range
+**********************************************************************/
+static bool inRange(u8 channel, f32 resistance){
+
+    return (bool)((resistance >= MIN_RESISTANCE) && (resistance <= MAX_RESISTANCE) &&
+                  ((chA == channel) || (chB == channel)));
+}
+
+/********************************************************************
+* FUNCTION   : u32 warmCheck(const DualPotWarmT *warm)
+* PURPOSE    : Checksum of a warm restart state
+* PARAMETERS : const DualPotWarmT *warm //state to check
+* RETURN     : u32                  //FNV-1a of the bytes before Check
+**********************************************************************/
+static u32 warmCheck(const DualPotWarmT *warm){
+    const u8 *byte = (const u8 *)warm;
+    u32 hash = 2166136261UL;                /* FNV-1a offset basis */
+    size_t i;
 
-    PeriodicIruptFlagClear();                       /* Clear interrupt flag */
+    for(i = 0U; i < offsetof(DualPotWarmT, Check); i++){
+        hash = (hash ^ byte[i]) * 16777619UL;
+    }
+    return hash;
 }
 
+/********************************************************************
+* FUNCTION   : u8 getTap(f32 resistance)
+* PURPOSE    : Calculate tap value for desired resistance
+* PARAMETERS : f32 resistance       //desired value of the resistance
+* RETURN     : u8
+**********************************************************************/
+u8 getTap(f32 resistance) {
 
+    /* return tap value for the provided  input resistance */
+    return DUALPOT_TAP(resistance);
+}
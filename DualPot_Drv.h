@@ -11,8 +11,27 @@
 #include "Pin.h"
 #include "Generic.h"
 #include "Periodic.h"
+#include <stddef.h>
 //#include <stdio.h>            /* for testing purpose */
 
+/******************************************************************************/
+//	types
+/******************************************************************************/
+typedef enum {
+    Initial = 0,            /* Initial state */
+    Setup1,                 /* Setup1 State */
+    Setup2,                 /* Setup2 State */
+    Running,                /* Running State */
+    Stop                    /* Done State */
+} Sig_states;
+
+typedef enum {
+    DualPotBatchScalar = 0,         /* portable C */
+    DualPotBatchSse2,               /* x86 SSE2, 8 samples per step */
+    DualPotBatchAvx,                /* x86 AVX, 16 samples per step */
+    DualPotBatchAuto                /* fastest path the CPU supports */
+} DualPotBatchIsaT;
+
 /******************************************************************************/
 //	variables
 /******************************************************************************/
@@ -22,6 +41,7 @@
 /******************************************************************************/
 #define chA 1U                      /* Channel A notation*/
 #define chB 2U                      /* Channel B notation*/
+#define DUALPOT_CH_QUAN 2U          /* quantity of supported channels */
 
 #define FULL_TAP 255U               /* Value for max digital output resistance*/
 #define MID_TAP 128U                /* Value for mid digital output resistance*/
@@ -31,12 +51,238 @@
 #define MIN_RESISTANCE ((f32)0)     /* Value for min input resistance*/
 #define TIMER_FREQ ((f32)40000)     /* Rollover frequency to attain 25us signal*/
 
+/* tap value for a range checked resistance, shared by getTap, the batch
+ * conversion and DualPot.hpp so all of them truncate identically */
+#define DUALPOT_TAP(resistance) ((u8)((resistance)/MAX_RESISTANCE * FULL_TAP))
+
+/* Channel state layouts, select one with DUALPOT_LAYOUT at build time */
+#define DUALPOT_LAYOUT_PACKED  0    /* byte-packed record per channel, flags as bitfields (least RAM) */
+#define DUALPOT_LAYOUT_ALIGNED 1    /* aligned record per channel, one byte per flag */
+#define DUALPOT_LAYOUT_SOA     2    /* struct of arrays, each field contiguous across channels */
+
+#ifndef DUALPOT_LAYOUT
+#define DUALPOT_LAYOUT DUALPOT_LAYOUT_PACKED
+#endif
+
+/* Potentiometer devices, select one with DUALPOT_DEVICE at build time */
+#define DUALPOT_DEVICE_MAX5389 0    /* up/down protocol, one tap per INC pulse */
+#define DUALPOT_DEVICE_SPI     1    /* SPI programmed wiper, any tap in one transaction */
+
+#ifndef DUALPOT_DEVICE
+#define DUALPOT_DEVICE DUALPOT_DEVICE_MAX5389
+#endif
+
+/* Runtime performance counters, 0 compiles them out */
+#ifndef DUALPOT_STATS
+#define DUALPOT_STATS 1
+#endif
+
+/* IsrMaxCycles, 1 reads the cycle counter twice per ISR call. Needs
+ * DUALPOT_STATS, and CYCLE_SOURCE on targets other than x86 (Cycle.h) */
+#ifndef DUALPOT_STATS_CYCLES
+#define DUALPOT_STATS_CYCLES 0
+#endif
+#if DUALPOT_STATS_CYCLES && !DUALPOT_STATS
+#error "DUALPOT_STATS_CYCLES needs DUALPOT_STATS"
+#endif
+
+/* ISR cycle histograms, 1 adds the profiler (DualPot_Profile.c) */
+#ifndef DUALPOT_PROFILE
+#define DUALPOT_PROFILE 0
+#endif
+
+/* Pin writes the ISR may issue per tick, 0 for no limit. Channels are
+ * served earliest deadline first, the ones left out wait for a later tick */
+#ifndef DUALPOT_PIN_BUDGET
+#define DUALPOT_PIN_BUDGET 0
+#endif
+
+/* Points per trajectory chunk, two chunks per channel are queued at a time */
+#ifndef DUALPOT_TRAJ_CHUNK
+#define DUALPOT_TRAJ_CHUNK 16U
+#endif
+
+/* INC pulses after which the next move from rest first runs into the end
+ * stop nearer the believed tap, 0 never (see DualPotDrv_Resync). That run
+ * takes the distance to the end stop plus DUALPOT_RESYNC_MARGIN pulses,
+ * the drift it recovers from */
+#ifndef DUALPOT_RESYNC_PULSES
+#define DUALPOT_RESYNC_PULSES 16384UL
+#endif
+#ifndef DUALPOT_RESYNC_MARGIN
+#define DUALPOT_RESYNC_MARGIN 16U
+#endif
+
+/* Timer ticks per ISR step the MAX5389 engine may fall back to after the
+ * handler overran its period, 1 keeps stepping every tick. Needs a timer
+ * with PERIODIC_ROLLOVERS (Periodic.h). The call after an overrun does not
+ * step if the late one did; an overrun that costs a step less than
+ * DUALPOT_STRIDE_BURST ticks after the one before doubles the ticks per
+ * step up to this, every DUALPOT_STRIDE_CALM ticks without an overrun
+ * halve them again */
+#ifndef DUALPOT_STRIDE_MAX
+#define DUALPOT_STRIDE_MAX 8U
+#endif
+#ifndef DUALPOT_STRIDE_CALM
+#define DUALPOT_STRIDE_CALM 512U
+#endif
+#ifndef DUALPOT_STRIDE_BURST
+#define DUALPOT_STRIDE_BURST 64U
+#endif
+
+#define DUALPOT_STATE_QUAN 5U       /* quantity of Sig_states */
+
+/* ISR branches, OR-ed into the index of DualPotProfileT.Branch */
+#define DUALPOT_BRANCH_CS_DROP    0x01U /* Setup1: chip select dropped */
+#define DUALPOT_BRANCH_UD_WRITE   0x02U /* Setup1 -> Setup2: U/D written */
+#define DUALPOT_BRANCH_INC_TOGGLE 0x04U /* Setup2/Running: INC toggled */
+#define DUALPOT_BRANCH_QUAN       8U    /* every combination of the above */
+
+#define DUALPOT_PROFILE_BUCKETS   16U   /* bucket b: cycles in [2^b, 2^(b+1)), last one open */
+
+#define DUALPOT_WARM_MAGIC   0x57505044UL   /* "DPPW" */
+#define DUALPOT_WARM_VERSION 1U
+
+/******************************************************************************/
+//	channel types
+/******************************************************************************/
+
+/* Snapshot of one channel, see DualPotDrv_GetStatus */
+typedef struct {
+    u8 CurrTap;                     /* tap the wiper is at */
+    u8 TargetTap;                   /* tap last requested */
+    u8 State;                       /* signal state, Sig_states */
+    u8 Late;                        /* 1 if the move missed its deadline */
+} DualPotChStatusT;
+
+/* Snapshot of all channels, taken at one point in time */
+typedef struct {
+    u32 Tick;                       /* timer ticks handled when the snapshot was last written */
+    DualPotChStatusT Ch[DUALPOT_CH_QUAN];   /* indexed by channel - chA */
+} DualPotStatusT;
+
+/* Settle time of one move, see DualPotDrv_EstimateSettle */
+typedef struct {
+    u32 Ticks;                      /* timer ticks from the request until the channel stops */
+    f32 Us;                         /* Ticks in microseconds at TIMER_FREQ */
+} DualPotSettleT;
+
+/* Driver state kept across a restart with the pots powered, filled by
+ * DualPotDrv_DeInitWarm and taken by DualPotDrv_InitWarm; 24 bytes, the
+ * caller keeps it wherever it survives the restart */
+typedef struct {
+    u32 Magic;                      /* DUALPOT_WARM_MAGIC */
+    u8 Version;                     /* DUALPOT_WARM_VERSION */
+    u8 Device;                      /* DUALPOT_DEVICE it was exported by */
+    u8 ChQuan;                      /* DUALPOT_CH_QUAN */
+    u8 Reserved;                    /* 0 */
+    u8 Tap[DUALPOT_CH_QUAN];        /* tap each wiper was left at */
+    u8 Up[DUALPOT_CH_QUAN];         /* 1 if the last move stepped up */
+    u32 Pulses[DUALPOT_CH_QUAN];    /* INC pulses since the last end stop, 0xFFFFFFFF
+                                     * if the tap is unsure and needs a resync */
+    u32 Check;                      /* FNV-1a of the bytes above */
+} DualPotWarmT;
+
+/* Completion callback: channel (chA/chB) and the tap it stopped at */
+typedef void (*DualPotDoneCbT)(u8 channel, u8 tap);
+
+/* One point of a trajectory, see DualPotDrv_TrajStart */
+typedef struct {
+    f32 Resistance;                 /* setpoint */
+    u32 Ticks;                      /* timer ticks until the next point, 0 counts as 1 */
+} DualPotPointT;
+
+/* Trajectory producer: write up to max points for channel, return how many;
+ * 0 ends the trajectory once the queued points are played */
+typedef size_t (*DualPotTrajFillCbT)(u8 channel, DualPotPointT *point, size_t max);
+
+/* Performance counters of one channel, see DualPotDrv_GetStats */
+typedef struct {
+    u32 StateTicks[DUALPOT_STATE_QUAN]; /* ISR ticks spent in each Sig_states */
+    u32 IncPulses;                  /* INC falling edges issued */
+    u32 Reversals;                  /* U/D input changes, moves reversing direction */
+    u32 Resyncs;                    /* moves through an end stop */
+    u32 Accepted;                   /* requests passing the range check */
+    u32 Rejected;                   /* requests failing the resistance range check */
+    u32 DeadlineMet;                /* moves stopped by their deadline */
+    u32 DeadlineMissed;             /* moves past their deadline */
+} DualPotChStatsT;
+
+/* Performance counters of the driver, counters wrap around */
+typedef struct {
+    u32 IsrCount;                   /* ISR invocations */
+    u32 IsrMaxCycles;               /* longest ISR, CycleNow() units, 0 unless DUALPOT_STATS_CYCLES */
+    u32 RejectedChannel;            /* requests for an unknown channel */
+    u32 EventsLost;                 /* ISR state changes the bottom half missed */
+    u32 IsrOverruns;                /* ISR calls that found timer rollovers passed without one */
+    u32 IsrSkipped;                 /* ISR calls that left the channels alone after overruns */
+    DualPotChStatsT Ch[DUALPOT_CH_QUAN];    /* indexed by channel - chA */
+} DualPotStatsT;
+
+/* Histogram of ISR durations, CycleNow() units */
+typedef struct {
+    u32 Count;                      /* ISR invocations recorded */
+    u32 MaxCycles;                  /* longest one */
+    u64 SumCycles;                  /* total, for the mean */
+    u32 Bucket[DUALPOT_PROFILE_BUCKETS];    /* power of two buckets */
+} DualPotHistT;
+
+/* ISR profile, see DualPotDrv_GetProfile */
+typedef struct {
+    DualPotHistT Branch[DUALPOT_BRANCH_QUAN];   /* by DUALPOT_BRANCH_x combination */
+    DualPotHistT Moving[DUALPOT_CH_QUAN + 1U];  /* by channels in Setup1..Running */
+} DualPotProfileT;
 
 /******************************************************************************/
 //	service functions
 /******************************************************************************/
 void DualPotDrv_Init(void);
 bool DualPotDrv_Main(u8 channel ,f32 resistance);
+bool DualPotDrv_MainDeadline(u8 channel, f32 resistance, u32 deadline);    /* deadline in ticks, 0 for none */
+bool DualPotDrv_MainTap(u8 channel, u8 tap, u32 deadline);     /* tap from DUALPOT_TAP, no float math */
 void DualPotDrv_DeInit(void);
+
+/* warm restart with the pots powered throughout: DeInitWarm stops the
+ * channels where they are and exports their state, InitWarm starts from it
+ * (False and a cold Init if it is missing, corrupt or from another build) */
+bool DualPotDrv_InitWarm(const DualPotWarmT *warm);
+void DualPotDrv_DeInitWarm(DualPotWarmT *warm);
+
+/* bottom half: completion callbacks, statistics and status; call from the
+ * main loop or a low priority interrupt (every DualPotDrv_Main runs it too) */
+void DualPotDrv_Deferred(void);
+void DualPotDrv_SetDoneCallback(DualPotDoneCbT cb);
+
+/* trajectory mode: the timer plays timed setpoints without DualPotDrv_Main
+ * calls, queued here or produced by fill (0 if none) from the bottom half */
+bool DualPotDrv_TrajStart(u8 channel, DualPotTrajFillCbT fill);
+size_t DualPotDrv_TrajQueue(u8 channel, const DualPotPointT *point, size_t n);
+void DualPotDrv_TrajStop(u8 channel);
+
+/* drive the wiper into the nearer end stop, where its position is known
+ * again, and on to the tap last requested; completes like a request */
+bool DualPotDrv_Resync(u8 channel);
+
+/* settle time of a request from the current state, and of a setpoint sequence
+ * requested one move after the other; nothing is moved */
+bool DualPotDrv_EstimateSettle(u8 channel, f32 resistance, DualPotSettleT *settle);
+size_t DualPotDrv_EstimateSettleBatch(u8 channel, const f32 *resistance, DualPotSettleT *settle, size_t n);
+
+/* read-only status snapshot, never blocks or masks the timer interrupt (DualPot_Status.c) */
+void DualPotDrv_GetStatus(DualPotStatusT *status);
+
+/* performance counters (DualPot_Stats.c) */
+void DualPotDrv_GetStats(DualPotStatsT *stats);
+void DualPotDrv_ClearStats(void);
+
+/* ISR cycle histograms, all zero unless built with DUALPOT_PROFILE 1 (DualPot_Profile.c) */
+void DualPotDrv_GetProfile(DualPotProfileT *profile);
+void DualPotDrv_ClearProfile(void);
+
+/* batch conversion for host side setpoint processing (DualPot_Batch.c) */
+size_t DualPotDrv_GetTapBatch(const f32 *resistance, u8 *tap, size_t n);
+void DualPotDrv_GetResistanceBatch(const u8 *tap, f32 *resistance, size_t n);
+void DualPotDrv_BatchIsaSet(DualPotBatchIsaT isa);
+DualPotBatchIsaT DualPotDrv_BatchIsa(void);
 //void ISR_Timer25us_Handler(void);         /* for testing purpose */
 #endif //MOTIV_DUALPOT_DRV_H
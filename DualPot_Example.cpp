@@ -0,0 +1,88 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Example.cpp
+* DESCRIPTION : DualPot driver through the C++ front end (DualPot.hpp)
+* NOTES : Moves both channels to constant setpoints, whose taps and pin
+*         masks the compiler computed, then to run time ones, on the
+*         simulated timer of a register level HAL. Checks the taps reached
+*         and that the port shows every channel released afterwards.
+*         usage: DualPot_Example
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#include <cstdio>
+#include "DualPot.hpp"
+
+extern "C" {
+#include "HalRegs.h"
+#include "PeriodicSim.h"
+}
+
+using Pots = motiv::DualPot<DUALPOT_CH_QUAN>;
+
+static constexpr motiv::DualPotSetpoint setpoint[DUALPOT_CH_QUAN] = {
+    Pots::At<chA>(6000.0f),
+    Pots::At<chB>(4000.0f)
+};
+static_assert(153U == setpoint[0].Tap, "6000 ohm is tap 153");
+static_assert(102U == setpoint[1].Tap, "4000 ohm is tap 102");
+static_assert(0x3FU == Pots::PortMask, "both channels use the whole port");
+//static constexpr motiv::DualPotSetpoint bad = Pots::At<chA>(12000.0f);  /* does not compile */
+
+#define EXAMPLE_MAX_TICKS 4000U     /* a full scale move takes about 2 * FULL_TAP ticks */
+
+/* poll like the application, two ticks between calls; ticks taken */
+template <class Request>
+static u32 settle(Request Poll){
+    u32 ticks = 0U;
+
+    while((false == Poll()) && (ticks < EXAMPLE_MAX_TICKS)){
+        PeriodicSimRun(2U);
+        ticks += 2U;
+    }
+    return ticks;
+}
+
+static int check(const char *What, const u8 (&Want)[DUALPOT_CH_QUAN], u32 Ticks){
+    u8 tap[DUALPOT_CH_QUAN];
+    u32 port = (u32)HAL_REGS->PinOut & Pots::PortMask;
+    int fails = 0;
+    u8 idx;
+
+    Pots::Taps(tap);
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if(Want[idx] != tap[idx]){
+            std::printf("%s: ch%u at tap %u, wanted %u\n", What, chA + idx, tap[idx], Want[idx]);
+            fails++;
+        }
+    }
+    if((port & Pots::ReleasedMask) != Pots::ReleasedMask){
+        std::printf("%s: port 0x%02X, a channel is still selected\n", What, port);
+        fails++;
+    }
+    std::printf("%s: taps %u %u after %u ticks (%.0f us), port 0x%02X\n", What, tap[0], tap[1], Ticks,
+                (double)Ticks * 1e6 / (double)Pots::Rate, port);
+    return fails;
+}
+
+int main(void) {
+    static const f32 resistance[DUALPOT_CH_QUAN] = {2500.0f, 9000.0f};
+    const u8 constWant[DUALPOT_CH_QUAN] = {setpoint[0].Tap, setpoint[1].Tap};
+    const u8 runWant[DUALPOT_CH_QUAN] = {Pots::Tap(resistance[0]), Pots::Tap(resistance[1])};
+    int fails = 0;
+    u32 ticks;
+
+    Pots::Init();
+
+    ticks = settle([]{ return Pots::MoveAll(setpoint, Pots::TicksMs(20U)); });
+    fails += check("constant", constWant, ticks);
+
+    ticks = settle([]{ return Pots::MoveAll(resistance); });
+    fails += check("run time", runWant, ticks);
+
+    if(false != Pots::Move(chA, 12000.0f)){
+        std::printf("out of range request accepted\n");
+        fails++;
+    }
+
+    Pots::DeInit();
+    return (0 == fails) ? 0 : 1;
+}
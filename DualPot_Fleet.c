@@ -0,0 +1,424 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Fleet.c
+* DESCRIPTION : Simulates a fleet of DualPot boards on all cores
+* NOTES : Every board is an independent driver instance with its own
+*         simulated timer and a pin level MAX5389 model. The driver is
+*         built with HAL_THREAD_LOCAL (DualPotDrvFleet), so each worker
+*         thread owns one instance and runs the boards it takes to
+*         completion on it, one after the other. Boards are dealt to one
+*         deque per worker; a worker pops its own from the back and, once
+*         empty, steals from the front of the others.
+*         A board replays a synthetic request profile (-n boards of -r
+*         requests) or one of the given setpoint logs (DualPot_Log.h).
+*         Reports settle times and INC pulses over the fleet, and the
+*         boards whose wiper model disagrees with the driver.
+*         usage: DualPot_Fleet [-t threads] [-n boards] [-r requests] [log...]
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "DualPot_Drv.h"
+#include "DualPot_Sim.h"
+#include "HalRegs.h"
+#include "Sync.h"
+
+#ifndef HAL_THREAD_LOCAL
+#error "DualPot_Fleet needs one driver instance per thread, link DualPotDrvFleet"
+#endif
+
+#define FLEET_STUCK_TICKS 100000U       /* ticks a move may take before the board fails */
+#define FLEET_THREADS_MAX 256U
+
+typedef struct {
+    DualPotSimSettleT Settle;           /* both channels of every board */
+    u64 Requests;                       /* records handed to the driver */
+    u64 Rejected;                       /* records failing the range check */
+    u64 Pulses;                         /* INC falling edges seen by the models */
+    u64 Ticks;                          /* timer ticks simulated */
+    u64 Boards;                         /* boards completed */
+    u64 Failed;                         /* boards disagreeing with their model or stuck */
+    u64 Steals;                         /* boards taken from another worker */
+} fleetStatsT;
+
+/* request source of one board */
+typedef struct {
+    FILE *File;                         /* setpoint log, 0 for a synthetic profile */
+    u32 RecSize;                        /* bytes per log record */
+    u64 Left;                           /* records still to hand out */
+    DualPotSimGenT Gen;                 /* synthetic profile generator */
+} boardSrcT;
+
+/* one simulated board */
+typedef struct {
+    DualPotSimT Sim;                    /* simulated time and requests in flight */
+    u32 PinPrev;                        /* port levels at the last sample */
+    u8 Wiper[DUALPOT_CH_QUAN];          /* MAX5389 model wiper */
+    u64 Edges[DUALPOT_CH_QUAN];         /* INC falling edges the model counted */
+} boardT;
+
+/* boards dealt to one worker, Head is stolen from, Tail popped by the owner */
+typedef struct {
+    pthread_mutex_t Lock;
+    u32 *Board;
+    u32 Head;
+    u32 Tail;
+} dequeT;
+
+typedef struct {
+    pthread_t Thread;
+    u32 Id;
+    dequeT Deque;
+    fleetStatsT Stats;
+} workerT;
+
+static workerT *worker;
+static u32 workerQuan;
+static char **logPath;                  /* one board per log, 0 for synthetic boards */
+static u64 profileRequests = 1000U;     /* requests per synthetic board */
+
+static SyncLocal boardT *board;         /* board the calling worker simulates */
+
+static u64 nowNs(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+/* next request of a board, False once the profile is played */
+static bool sourceNext(boardSrcT *Src, DualPotLogRecT *Rec){
+
+    if(0U == Src->Left){
+        return False;
+    }
+    Src->Left--;
+
+    if(0 != Src->File){
+        if(1U != fread(Rec, sizeof(*Rec), 1U, Src->File)){
+            return False;
+        }
+        if(Src->RecSize > sizeof(*Rec)){
+            (void)fseek(Src->File, (long)(Src->RecSize - sizeof(*Rec)), SEEK_CUR);
+        }
+        return True;
+    }
+
+    DualPotSimGen_Next(&Src->Gen, Rec);
+    return True;
+}
+
+static bool sourceOpen(boardSrcT *Src, u32 Board){
+    DualPotLogHdrT hdr;
+
+    memset(Src, 0, sizeof(*Src));
+    if(0 == logPath){
+        Src->Left = profileRequests;
+        DualPotSimGen_Init(&Src->Gen, Board * 2654435761U + 1U);   /* board 0 plays DualPot_Replay -g */
+        return True;
+    }
+
+    Src->File = fopen(logPath[Board], "rb");
+    if(0 == Src->File){
+        perror(logPath[Board]);
+        return False;
+    }
+    if((1U != fread(&hdr, sizeof(hdr), 1U, Src->File)) || (DUALPOT_LOG_MAGIC != hdr.Magic) ||
+       (DUALPOT_LOG_VERSION != hdr.Version) || (hdr.RecSize < sizeof(DualPotLogRecT))){
+        fprintf(stderr, "%s: not a version %lu setpoint log\n", logPath[Board], DUALPOT_LOG_VERSION);
+        (void)fclose(Src->File);
+        return False;
+    }
+    Src->RecSize = hdr.RecSize;
+    Src->Left = ~0ULL;                  /* until the end of the file */
+    return True;
+}
+
+/* MAX5389 model: the wiper steps on an INC falling edge while CS is low,
+ * up with U/D high; at most one edge per pin and tick, so a sample after
+ * every tick and every driver call sees them all */
+static void modelSample(void *Ctx){
+    boardT *B = (boardT *)Ctx;
+    u32 pins = HAL_REGS->PinOut;
+    u8 idx;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if((0UL != (B->PinPrev & (1UL << (PinINCA + idx)))) &&
+           (0UL == (pins & (1UL << (PinINCA + idx)))) &&
+           (0UL == (pins & (1UL << (PinCSA + idx))))){
+            B->Edges[idx]++;
+            if(0UL != (pins & (1UL << (PinUDA + idx)))){
+                if(FULL_TAP > B->Wiper[idx]){
+                    B->Wiper[idx]++;
+                }
+            }else{
+                if(MIN_TAP < B->Wiper[idx]){
+                    B->Wiper[idx]--;
+                }
+            }
+        }
+    }
+    B->PinPrev = pins;
+}
+
+/* completion callback: settle time of the pending request */
+static void onDone(u8 Channel, u8 Tap){
+
+    (void)Tap;
+    DualPotSim_Done(&board->Sim, Channel);
+}
+
+/* hand one record to the driver */
+static void request(boardT *B, fleetStatsT *Stats, const DualPotLogRecT *Rec){
+
+    Stats->Requests++;
+    if(False == DualPotSim_Valid(Rec)){
+        Stats->Rejected++;
+        return;
+    }
+    DualPotSim_Request(&B->Sim, Rec);
+    modelSample(B);
+}
+
+/* simulate one board to completion on the instance of the calling thread */
+static void boardRun(u32 Board, fleetStatsT *Stats){
+    DualPotStatusT status;
+    DualPotStatsT drvStats;
+    DualPotLogRecT rec;
+    boardSrcT src;
+    boardT b;
+    u64 firstUs = 0U;
+    u64 stuck;
+    bool first = True;
+    bool ok = True;
+    u8 idx;
+
+    if(False == sourceOpen(&src, Board)){
+        Stats->Failed++;
+        return;
+    }
+
+    memset(&b, 0, sizeof(b));
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        b.Sim.Settle[idx] = &Stats->Settle;
+    }
+    b.Sim.Sample = modelSample;
+    b.Sim.Ctx = &b;
+    board = &b;
+
+    DualPotDrv_Init();
+    DualPotDrv_ClearStats();
+    DualPotDrv_SetDoneCallback(onDone);
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        b.Wiper[idx] = MID_TAP;             /* power-on wiper */
+    }
+    b.PinPrev = HAL_REGS->PinOut;
+
+    while(True == sourceNext(&src, &rec)){
+        if(True == first){
+            firstUs = rec.TimeUs;
+            first = False;
+        }
+        if(rec.TimeUs > firstUs){
+            DualPotSim_Advance(&b.Sim, (rec.TimeUs - firstUs) * (u64)TIMER_FREQ / 1000000ULL);
+        }
+        request(&b, Stats, &rec);
+    }
+    if(0 != src.File){
+        (void)fclose(src.File);
+    }
+
+    /* let the last moves complete */
+    stuck = b.Sim.Tick + FLEET_STUCK_TICKS;
+    while((True == DualPotSim_Busy(&b.Sim)) && (b.Sim.Tick < stuck)){
+        DualPotSim_Advance(&b.Sim, b.Sim.Tick + 1U);
+    }
+    Stats->Ticks += b.Sim.Ran;
+
+    DualPotDrv_Deferred();
+    DualPotDrv_GetStatus(&status);
+    DualPotDrv_GetStats(&drvStats);
+    ok = (bool)(False == DualPotSim_Busy(&b.Sim));
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        Stats->Pulses += b.Edges[idx];
+        if(status.Ch[idx].CurrTap != b.Wiper[idx]){
+            ok = False;
+        }
+#if DUALPOT_STATS
+        if((u64)drvStats.Ch[idx].IncPulses != b.Edges[idx]){
+            ok = False;
+        }
+#endif
+    }
+    if(False == ok){
+        Stats->Failed++;
+        fprintf(stderr, "board %u: driver tap %u/%u, model %u/%u%s\n", Board,
+                status.Ch[0].CurrTap, status.Ch[1].CurrTap, b.Wiper[0], b.Wiper[1],
+                (True == DualPotSim_Busy(&b.Sim)) ? ", stuck" : "");
+    }
+    Stats->Boards++;
+
+    DualPotDrv_DeInit();
+    board = 0;
+}
+
+/* next board for Self: its own newest, else the oldest of another worker */
+static bool boardTake(workerT *Self, u32 *Board){
+    dequeT *dq = &Self->Deque;
+    bool got = False;
+    u32 i;
+
+    pthread_mutex_lock(&dq->Lock);
+    if(dq->Head != dq->Tail){
+        dq->Tail--;
+        *Board = dq->Board[dq->Tail];
+        got = True;
+    }
+    pthread_mutex_unlock(&dq->Lock);
+
+    for(i = 1U; (False == got) && (i < workerQuan); i++){
+        dq = &worker[(Self->Id + i) % workerQuan].Deque;
+        pthread_mutex_lock(&dq->Lock);
+        if(dq->Head != dq->Tail){
+            *Board = dq->Board[dq->Head];
+            dq->Head++;
+            got = True;
+            Self->Stats.Steals++;
+        }
+        pthread_mutex_unlock(&dq->Lock);
+    }
+    return got;
+}
+
+static void *workerMain(void *Arg){
+    workerT *self = (workerT *)Arg;
+    u32 b;
+
+    while(True == boardTake(self, &b)){
+        boardRun(b, &self->Stats);
+    }
+    return 0;
+}
+
+static void statsMerge(fleetStatsT *Sum, const fleetStatsT *Part){
+
+    DualPotSim_SettleMerge(&Sum->Settle, &Part->Settle);
+    Sum->Requests += Part->Requests;
+    Sum->Rejected += Part->Rejected;
+    Sum->Pulses += Part->Pulses;
+    Sum->Ticks += Part->Ticks;
+    Sum->Boards += Part->Boards;
+    Sum->Failed += Part->Failed;
+    Sum->Steals += Part->Steals;
+}
+
+static void report(const fleetStatsT *Sum, u64 WallNs){
+    const DualPotSimSettleT *settle = &Sum->Settle;
+    double wallS = (double)WallNs / 1e9;
+    double simS = (double)Sum->Ticks / (double)TIMER_FREQ;
+    double tickUs = 1e6 / (double)TIMER_FREQ;
+    u32 i;
+
+    printf("boards %llu on %u threads in %.3f s: %.0f boards/s, %.0f requests/s\n",
+           (unsigned long long)Sum->Boards, workerQuan, wallS,
+           (double)Sum->Boards / wallS, (double)Sum->Requests / wallS);
+    printf("simulated %.1f s of moving time, %.1fx real time, %llu steals\n",
+           simS, simS / wallS, (unsigned long long)Sum->Steals);
+    for(i = 0U; i < workerQuan; i++){
+        printf("  thread %u  boards %llu  steals %llu\n", i,
+               (unsigned long long)worker[i].Stats.Boards, (unsigned long long)worker[i].Stats.Steals);
+    }
+    printf("requests %llu  moves %llu  no move %llu  superseded %llu  rejected %llu\n",
+           (unsigned long long)Sum->Requests, (unsigned long long)settle->Moves,
+           (unsigned long long)settle->NoMove, (unsigned long long)settle->Superseded,
+           (unsigned long long)Sum->Rejected);
+    if(0U != settle->Moves){
+        printf("settle ticks  mean %.1f  p50 %llu  p99 %llu  max %llu  (max %.0f us)\n",
+               (double)settle->SumTicks / (double)settle->Moves,
+               (unsigned long long)DualPotSim_Percentile(settle, 0.50),
+               (unsigned long long)DualPotSim_Percentile(settle, 0.99),
+               (unsigned long long)settle->MaxTicks, (double)settle->MaxTicks * tickUs);
+        printf("inc pulses %llu, %.1f per move\n",
+               (unsigned long long)Sum->Pulses, (double)Sum->Pulses / (double)settle->Moves);
+    }
+    printf("boards failing the model check %llu\n", (unsigned long long)Sum->Failed);
+}
+
+int main(int argc, char *argv[]) {
+    fleetStatsT *sum;
+    u64 boards = 1000U;
+    u64 wall0;
+    u32 per;
+    u32 w;
+    u32 b;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    workerQuan = (cpus > 0) ? (u32)cpus : 1U;
+    while(-1 != (opt = getopt(argc, argv, "t:n:r:"))){
+        switch(opt){
+        case 't':
+            workerQuan = (u32)strtoul(optarg, 0, 10);
+            break;
+        case 'n':
+            boards = strtoull(optarg, 0, 10);
+            break;
+        case 'r':
+            profileRequests = strtoull(optarg, 0, 10);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-t threads] [-n boards] [-r requests] [log...]\n", argv[0]);
+            return 2;
+        }
+    }
+    if(optind < argc){
+        logPath = &argv[optind];
+        boards = (u64)(argc - optind);
+    }
+    if((0U == workerQuan) || (FLEET_THREADS_MAX < workerQuan) || (0U == boards) || (0xFFFFFFFFULL < boards)){
+        fprintf(stderr, "%s: 1..%u threads and at least one board\n", argv[0], FLEET_THREADS_MAX);
+        return 2;
+    }
+
+    /* deal the boards in contiguous blocks, stealing evens out the rest */
+    worker = (workerT *)calloc(workerQuan, sizeof(workerT));
+    sum = (fleetStatsT *)calloc(1U, sizeof(fleetStatsT));
+    if((0 == worker) || (0 == sum)){
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return 1;
+    }
+    per = (u32)((boards + workerQuan - 1U) / workerQuan);
+    for(w = 0U; w < workerQuan; w++){
+        worker[w].Id = w;
+        pthread_mutex_init(&worker[w].Deque.Lock, 0);
+        worker[w].Deque.Board = (u32 *)malloc((size_t)per * sizeof(u32));
+        if(0 == worker[w].Deque.Board){
+            fprintf(stderr, "%s: out of memory\n", argv[0]);
+            return 1;
+        }
+        for(b = w * per; (b < (w + 1U) * per) && ((u64)b < boards); b++){
+            worker[w].Deque.Board[worker[w].Deque.Tail] = b;
+            worker[w].Deque.Tail++;
+        }
+    }
+
+    wall0 = nowNs();
+    for(w = 0U; w < workerQuan; w++){
+        if(0 != pthread_create(&worker[w].Thread, 0, workerMain, &worker[w])){
+            fprintf(stderr, "%s: cannot start thread %u\n", argv[0], w);
+            return 1;
+        }
+    }
+    for(w = 0U; w < workerQuan; w++){
+        (void)pthread_join(worker[w].Thread, 0);
+        statsMerge(sum, &worker[w].Stats);
+    }
+
+    report(sum, nowNs() - wall0);
+    return (0U == sum->Failed) ? 0 : 1;
+}
@@ -0,0 +1,342 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Jitter.c
+* DESCRIPTION : DualPot driver against a real-time timer thread
+* NOTES : Built with DUALPOT_HAL=THREAD. ISR_Timer25us_Handler runs on the
+*         timer thread of HalThread.c at TIMER_FREQ while this program's
+*         main loop calls DualPotDrv_Main on another core, as the
+*         application does on the Linux based controllers. Every move is
+*         polled to completion, some are retargeted half way, and the
+*         tap reached is checked against the request, so races between
+*         the two threads show up as stuck moves or wrong taps.
+*         Reports wake-up lateness of the timer thread, lost rollovers
+*         (overruns), the longest handler call and the move checks.
+*         The timer thread asks for SCHED_FIFO; without the privilege it
+*         runs at the default policy and the report says so.
+*         -s stresses the handoff of requests to the ISR instead: bursts
+*         of requests for random targets, spaced so they land at every
+*         point of a tick and often supersede one the ISR has not taken
+*         yet, each burst settled and checked against a MAX5389 model fed
+*         from the port after every handler call.
+*         usage: DualPot_Jitter [-s] [-d seconds] [-c timer cpu] [-p priority]
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "DualPot_Drv.h"
+#include "HalRegs.h"
+#include "PeriodicThread.h"
+
+/* a move polled this long without completing is stuck; overruns may slow
+ * the driver to one step in DUALPOT_STRIDE_MAX ticks */
+#define JITTER_STUCK_NS   (100000000ULL * DUALPOT_STRIDE_MAX)
+#define JITTER_RETARGET   16U           /* one move in this many is retargeted half way */
+#define JITTER_BURST      32U           /* most requests of a stress burst */
+#define JITTER_GAP_NS     40000U        /* most time between two of them */
+
+void ISR_Timer25us_Handler(void);       /* DualPot_Max5389.c */
+
+static u32 seed = 1U;
+static u64 doneCalls;                   /* completion callbacks */
+
+/* MAX5389 model of the stress mode, timer thread only */
+static u32 modelPins;                   /* port levels at the last sample */
+static u8 modelWiper[DUALPOT_CH_QUAN];
+static u32 modelEdges[DUALPOT_CH_QUAN]; /* INC falling edges, as IncPulses */
+
+static u64 nowNs(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+static u32 randomNext(void){
+    seed = seed * 1103515245U + 12345U;
+    return seed >> 8;
+}
+
+static void onDone(u8 Channel, u8 Tap){
+
+    (void)Channel;
+    (void)Tap;
+    doneCalls++;
+}
+
+/* handler of the stress mode: the driver's, then the model follows the
+ * port; the wiper steps on an INC falling edge while CS is low, up with
+ * U/D high. The driver writes the pins from the handler only, at most one
+ * INC edge per channel and call */
+static void stressTick(void){
+    u32 pins;
+    u8 idx;
+
+    ISR_Timer25us_Handler();
+    pins = HAL_REGS->PinOut;
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if((0UL != (modelPins & (1UL << (PinINCA + idx)))) &&
+           (0UL == (pins & (1UL << (PinINCA + idx)))) &&
+           (0UL == (pins & (1UL << (PinCSA + idx))))){
+            modelEdges[idx]++;
+            if(0UL != (pins & (1UL << (PinUDA + idx)))){
+                if(FULL_TAP > modelWiper[idx]){
+                    modelWiper[idx]++;
+                }
+            }else{
+                if(MIN_TAP < modelWiper[idx]){
+                    modelWiper[idx]--;
+                }
+            }
+        }
+    }
+    modelPins = pins;
+}
+
+static void spin(u64 Ns){
+    u64 until = nowNs() + Ns;
+
+    while(nowNs() < until){
+        /* the request lands somewhere in a tick */
+    }
+}
+
+/* bursts of requests until Seconds are over; failures */
+static u64 stress(double Seconds){
+    DualPotStatusT status;
+    DualPotStatsT stats;
+    f32 target[DUALPOT_CH_QUAN] = {5000.0f, 5000.0f};
+    u8 want[DUALPOT_CH_QUAN];
+    u64 end = nowNs() + (u64)(Seconds * 1e9);
+    u64 begin;
+    u64 started;
+    u64 took;
+    u64 callMax = 0U;
+    u64 requests = 0U;
+    u64 bursts = 0U;
+    u64 stuck = 0U;
+    u64 wrong = 0U;
+    u32 quan;
+    u32 i;
+    u8 ch;
+    u8 idx;
+    bool done;
+
+    /* the driver configures the timer on its first move; once that settled,
+     * stressTick takes the handler over and the model starts from the port
+     * levels, taps and edges the move left */
+    while(False == DualPotDrv_Main(chA, 0.0f)){
+        spin(JITTER_GAP_NS);
+    }
+    PeriodicIruptDisable();
+    DualPotDrv_GetStatus(&status);
+    DualPotDrv_GetStats(&stats);
+    modelPins = HAL_REGS->PinOut;
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        modelWiper[idx] = status.Ch[idx].CurrTap;
+        modelEdges[idx] = stats.Ch[idx].IncPulses;
+    }
+    PeriodicConfig(TIMER_FREQ, stressTick);
+    PeriodicIruptEnable();
+
+    begin = nowNs();
+    while(nowNs() < end){
+        quan = 1U + (randomNext() % JITTER_BURST);
+        for(i = 0U; i < quan; i++){
+            ch = (u8)(chA + (randomNext() % DUALPOT_CH_QUAN));
+            target[ch - chA] = (f32)(randomNext() % 10001U);
+            started = nowNs();
+            (void)DualPotDrv_Main(ch, target[ch - chA]);
+            took = nowNs() - started;
+            if(took > callMax){
+                callMax = took;
+            }
+            requests++;
+            spin(randomNext() % JITTER_GAP_NS);
+        }
+        bursts++;
+
+        /* settle on the last target of each channel */
+        started = nowNs();
+        do{
+            (void)DualPotDrv_Main(chA, target[0]);
+            done = DualPotDrv_Main(chB, target[1]);
+        }while((False == done) && ((nowNs() - started) < JITTER_STUCK_NS));
+
+        (void)DualPotDrv_GetTapBatch(target, want, DUALPOT_CH_QUAN);
+        PeriodicIruptDisable();             /* a handler call in progress has sampled */
+        DualPotDrv_GetStatus(&status);
+        DualPotDrv_GetStats(&stats);
+        if(False == done){
+            stuck++;
+            fprintf(stderr, "burst %llu stuck: taps %u %u, states %u %u\n", (unsigned long long)bursts,
+                    status.Ch[0].CurrTap, status.Ch[1].CurrTap, status.Ch[0].State, status.Ch[1].State);
+        }
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            if((True == done) && ((want[idx] != status.Ch[idx].CurrTap) || (want[idx] != modelWiper[idx]) ||
+                                  (modelEdges[idx] != stats.Ch[idx].IncPulses))){
+                wrong++;
+                fprintf(stderr, "burst %llu ch%u: requested %u, driver %u, model %u, edges %u/%u\n",
+                        (unsigned long long)bursts, chA + idx, want[idx], status.Ch[idx].CurrTap,
+                        modelWiper[idx], stats.Ch[idx].IncPulses, modelEdges[idx]);
+                modelWiper[idx] = status.Ch[idx].CurrTap;   /* report each disagreement once */
+                modelEdges[idx] = stats.Ch[idx].IncPulses;
+            }
+        }
+        PeriodicIruptEnable();
+    }
+
+    printf("%.1f s, %llu requests in %llu bursts, longest DualPotDrv_Main call %llu ns\n",
+           (double)(nowNs() - begin) / 1e9, (unsigned long long)requests, (unsigned long long)bursts,
+           (unsigned long long)callMax);
+    printf("bursts stuck %llu  channels off target or off the model %llu\n",
+           (unsigned long long)stuck, (unsigned long long)wrong);
+    printf("isr overruns %u  calls without a step %u\n", stats.IsrOverruns, stats.IsrSkipped);
+    return stuck + wrong;
+}
+
+/* upper bound of the bucket holding the Quantile of the wake-ups, ns */
+static u64 lateQuantile(const PeriodicThreadStatsT *Stats, double Quantile){
+    u64 total = 0U;
+    u64 seen = 0U;
+    u64 want;
+    u32 b;
+
+    for(b = 0U; b < PERIODIC_THREAD_BUCKETS; b++){
+        total += Stats->LateHist[b];
+    }
+    want = (u64)((double)total * Quantile + 0.999999);
+    for(b = 0U; b < (PERIODIC_THREAD_BUCKETS - 1U); b++){
+        seen += Stats->LateHist[b];
+        if(seen >= want){
+            break;
+        }
+    }
+    return 2ULL << b;
+}
+
+int main(int argc, char *argv[]) {
+    PeriodicThreadStatsT timing;
+    DualPotStatusT status;
+    DualPotStatsT stats;
+    double seconds = 5.0;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    s32 timerCpu = -1;
+    s32 priority = 80;
+    u64 end;
+    u64 begin;
+    u64 started;
+    u64 calls = 0U;
+    u64 moves = 0U;
+    u64 retargets = 0U;
+    u64 stuck = 0U;
+    u64 wrong = 0U;
+    u64 failed;
+    f32 res;
+    u8 ch;
+    u8 want;
+    bool done;
+    bool retarget;
+    bool stressMode = False;
+    int opt;
+
+    if(cpus > 1){
+        timerCpu = (s32)(cpus - 1);         /* application stays on the others */
+    }
+    while(-1 != (opt = getopt(argc, argv, "sd:c:p:"))){
+        switch(opt){
+        case 's':
+            stressMode = True;
+            break;
+        case 'd':
+            seconds = atof(optarg);
+            break;
+        case 'c':
+            timerCpu = (s32)atol(optarg);
+            break;
+        case 'p':
+            priority = (s32)atol(optarg);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-s] [-d seconds] [-c timer cpu] [-p priority]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    PeriodicThreadPlace(timerCpu, priority);
+    DualPotDrv_Init();
+    DualPotDrv_ClearStats();
+    DualPotDrv_SetDoneCallback(onDone);
+
+    if(True == stressMode){
+        failed = stress(seconds);
+        DualPotDrv_DeInit();
+        PeriodicThreadExit();
+        PeriodicThreadStats(&timing);
+        printf("timer thread: overruns %llu of %llu rollovers, longest handler call %u ns\n",
+               (unsigned long long)timing.Overruns, (unsigned long long)timing.Ticks, timing.HandlerMaxNs);
+        return (0U == failed) ? 0 : 1;
+    }
+
+    begin = nowNs();
+    end = begin + (u64)(seconds * 1e9);
+    while(nowNs() < end){
+        ch = (u8)(chA + (randomNext() % DUALPOT_CH_QUAN));
+        res = (f32)(randomNext() % 10001U);
+        retarget = (bool)(0U == (randomNext() % JITTER_RETARGET));
+        started = nowNs();
+
+        do{
+            done = DualPotDrv_Main(ch, res);
+            calls++;
+            if((True == retarget) && (False == done) && ((nowNs() - started) > 2000000ULL)){
+                res = (f32)(randomNext() % 10001U);     /* new target while moving */
+                retarget = False;
+                retargets++;
+            }
+        }while((False == done) && ((nowNs() - started) < JITTER_STUCK_NS));
+
+        (void)DualPotDrv_GetTapBatch(&res, &want, 1U);
+        DualPotDrv_GetStatus(&status);
+        if(False == done){
+            stuck++;
+            fprintf(stderr, "ch%u stuck: tap %u, target %u, state %u\n", ch,
+                    status.Ch[ch - chA].CurrTap, want, status.Ch[ch - chA].State);
+        }else if(want != status.Ch[ch - chA].CurrTap){
+            wrong++;
+            fprintf(stderr, "ch%u done at tap %u, requested %u\n", ch, status.Ch[ch - chA].CurrTap, want);
+        }else{
+            moves++;
+        }
+    }
+    end = nowNs();
+
+    DualPotDrv_DeInit();
+    PeriodicThreadExit();
+    PeriodicThreadStats(&timing);
+    DualPotDrv_GetStats(&stats);
+
+    printf("%.1f s, timer thread on cpu %d, %s\n", (double)(end - begin) / 1e9, (int)timerCpu,
+           (True == timing.RealTime) ? "SCHED_FIFO" : "default policy (no real-time privilege)");
+    printf("rollovers %llu  handler calls %llu  overruns %llu (%.1f ppm)\n",
+           (unsigned long long)timing.Ticks, (unsigned long long)timing.Calls,
+           (unsigned long long)timing.Overruns,
+           (0U != timing.Ticks) ? (double)timing.Overruns * 1e6 / (double)timing.Ticks : 0.0);
+    if(0U != timing.Ticks){
+        printf("wake-up lateness  mean %.0f ns  p50 < %llu ns  p99 < %llu ns  p99.9 < %llu ns  max %u ns\n",
+               (double)timing.LateSumNs / (double)(timing.Ticks - timing.Overruns),
+               (unsigned long long)lateQuantile(&timing, 0.50),
+               (unsigned long long)lateQuantile(&timing, 0.99),
+               (unsigned long long)lateQuantile(&timing, 0.999), timing.LateMaxNs);
+    }
+    printf("longest handler call %u ns, period %.0f ns\n", timing.HandlerMaxNs, 1e9 / (double)TIMER_FREQ);
+    printf("moves %llu  retargeted %llu  stuck %llu  wrong tap %llu  main calls %llu  callbacks %llu\n",
+           (unsigned long long)moves, (unsigned long long)retargets, (unsigned long long)stuck,
+           (unsigned long long)wrong, (unsigned long long)calls, (unsigned long long)doneCalls);
+    printf("isr %u  events lost %u  isr overruns %u  calls without a step %u\n", stats.IsrCount,
+           stats.EventsLost, stats.IsrOverruns, stats.IsrSkipped);
+
+    return ((0U == stuck) && (0U == wrong)) ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+/******************************************************************************/
+//	DualPot_Log.h
+/******************************************************************************/
+
+#ifndef MOTIV_DUALPOT_LOG_H
+#define MOTIV_DUALPOT_LOG_H
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include "DualPot_Drv.h"
+
+/******************************************************************************/
+//	macros
+/******************************************************************************/
+#define DUALPOT_LOG_MAGIC   0x474C5044UL    /* "DPLG" */
+#define DUALPOT_LOG_VERSION 1UL
+
+/******************************************************************************/
+//	types
+/*
+	- recorded setpoint log: one header, then records in time order,
+	  little endian as written by the recording host
+	- RecSize lets later versions append fields, readers skip them
+*/
+/******************************************************************************/
+typedef struct {
+    u32 Magic;                      /* DUALPOT_LOG_MAGIC */
+    u32 Version;                    /* DUALPOT_LOG_VERSION */
+    u32 RecSize;                    /* bytes per record, at least sizeof(DualPotLogRecT) */
+    u32 Reserved;
+} DualPotLogHdrT;
+
+typedef struct {
+    u64 TimeUs;                     /* microseconds since the start of the recording */
+    f32 Resistance;                 /* requested resistance */
+    u8 Channel;                     /* chA/chB as passed to DualPotDrv_Main */
+    u8 Reserved[3];
+} DualPotLogRecT;
+
+#endif //MOTIV_DUALPOT_LOG_H
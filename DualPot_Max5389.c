@@ -0,0 +1,2066 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Max5389.c
+* DESCRIPTION : MAX5389 up/down protocol device for the DualPot driver
+* PUBLIC FUNCTIONS :
+*           const DualPotDevT DualPotDev_Max5389
+*           void ISR_Timer25us_Handler(void)
+* NOTES : This device means to control
+*         a dual-channel digital potentiometer (MAX5389, 10 kΩ model)
+*         through its CS, U/D and INC inputs, one tap per INC pulse.
+*         Requests reach the ISR through a command slot per channel:
+*         DualPotDrv_Main publishes the target tap, the ISR takes it at
+*         its next tick and plans the move from the tap it is at, so the
+*         move state has a single writer and interrupts are never masked.
+*         The ISR then only emits the edges due each tick: it drops CS,
+*         writes the planned U/D level and toggles INC until the planned
+*         number of falling edges is out. The bottom half
+*         (max5389Deferred, also run by every request) derives the wiper
+*         tap from the edge count, reports completion, folds the ISR
+*         events into the statistics, stops the idle timer and publishes
+*         the status while it is stopped. While it runs the ISR publishes
+*         on the ticks that change the status, and on the next one after
+*         the bottom half changed it.
+*         The ISR still plans each move itself: the plan starts from the
+*         tap the wiper is at when the command is taken, which only the
+*         ISR knows, and a plan made elsewhere would give the move state
+*         a second writer. Planning runs on the tick a command or a
+*         trajectory point is taken, not on every tick.
+*         A resync drives the wiper into the end stop nearer the tap it
+*         is believed at, beyond which INC pulses have no effect, and moves
+*         on to the target from there without releasing the chip; the ISR
+*         starts one on DualPotDrv_Resync and, once DUALPOT_RESYNC_PULSES
+*         pulses were issued since the last one, on the next move from rest.
+*         In trajectory mode the ISR also plays the queued setpoints of a
+*         channel, retargeting it as each point falls due, while the
+*         bottom half refills the chunk already played.
+*         Channels are served earliest deadline first, those without a
+*         deadline after them in channel order. With DUALPOT_PIN_BUDGET
+*         set, a channel whose pin writes no longer fit into the tick
+*         waits for a later one.
+*         Init only resets the channel state and releases the chips with
+*         one port write; the timer is configured by the first move, so a
+*         driver that is never asked to move leaves it alone.
+*         With a timer that counts rollovers (PERIODIC_ROLLOVERS), a
+*         handler call that finds rollovers passed since the one before
+*         (an overrun) leaves the pins alone if that call stepped: its
+*         late pin writes may be just before it. Overruns less than
+*         DUALPOT_STRIDE_BURST ticks apart make the ISR step on every
+*         second, fourth.. tick, up to DUALPOT_STRIDE_MAX, halving back
+*         every DUALPOT_STRIDE_CALM ticks without one. Moves take longer, the edges keep their timing.
+* AUTHOR : Sarika Natu         DATE : 22 Jun 2020
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   19Jun2020   SN      Dual pot driver implementation
+* 0.2.0   21Jun2020   SN      Multichannel support
+* 0.3.0   18Oct2026   agent   Compile-time selectable channel state layout
+* 0.3.1   18Oct2026   agent   Flush shadowed pin writes once per tick
+* 0.4.0   18Oct2026   agent   Split from DualPot_Drv.c as a DualPotDevT device
+* 0.5.0   18Oct2026   agent   Taps counted and moves completed by the ISR,
+*                             channels re-armed after Stop, status snapshot
+* 0.6.0   18Oct2026   agent   Performance counters
+* 0.6.1   18Oct2026   agent   ISR profiler hooks
+* 0.7.0   18Oct2026   agent   Deferred bottom half for tap tracking,
+*                             completion, statistics and status
+* 0.7.1   18Oct2026   agent   Settle time prediction
+* 0.8.0   18Oct2026   agent   Earliest deadline first channel order,
+*                             per-tick pin budget, deadline misses
+* 0.9.0   18Oct2026   agent   Trajectory mode, double buffered setpoint
+*                             chunks played by the ISR
+* 0.9.1   18Oct2026   agent   Thread local state for the fleet simulation
+* 0.9.2   18Oct2026   agent   Not done on a stop the ISR made after
+*                             completeMoves ran
+* 1.0.0   18Oct2026   agent   Requests handed to the ISR through a double
+*                             buffered command slot, the ISR plans the move
+* 1.1.0   18Oct2026   agent   Resync through the nearer end stop, on request
+*                             and after DUALPOT_RESYNC_PULSES pulses
+* 1.2.0   18Oct2026   agent   Warm restart: taps, direction and resync
+*                             pulses exported by DeInit, taken by Init;
+*                             DeInit stops the timer
+* 1.3.0   18Oct2026   agent   Init drives all channel pins in one port
+*                             write, the timer is configured on the
+*                             first move
+* 1.3.1   18Oct2026   agent   A move begun on a selected channel waits a
+*                             tick after its U/D change or INC rise
+*                             before the first INC edge
+* 1.4.0   18Oct2026   agent   ISR overruns counted, fewer steps per tick
+*                             while they last
+* 1.4.1   18Oct2026   agent   Status snapshot published by the ISR while
+*                             the timer runs, by the bottom half while
+*                             it is stopped
+* 1.4.2   18Oct2026   agent   ISR timed only with DUALPOT_STATS_CYCLES
+* 1.4.3   18Oct2026   agent   Overrun handling optional (PERIODIC_ROLLOVERS);
+*                             stride doubles on overrun bursts only and
+*                             decays by ticks, one skip per late step
+* 1.4.4   18Oct2026   agent   Status published by the ISR on ticks that
+*                             change it; the timer is stopped without
+*                             masking its interrupt
+* 1.4.5   18Oct2026   agent   First timer start configures it without
+*                             disabling its interrupt first
+*H***********************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include "DualPot_Dev.h"
+#include "Sync.h"
+#if DUALPOT_STATS_CYCLES || DUALPOT_PROFILE
+#include "Cycle.h"
+#endif
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+#if (DUALPOT_LAYOUT == DUALPOT_LAYOUT_PACKED)
+/* Packed layout: one byte-packed record per channel, flags as bitfields.
+ * Smallest RAM footprint, every flag update is a read-modify-write */
+#pragma pack(push, 1)
+SyncLocal struct DigiPot{
+    u8 channel:8;               /* Channel indication */
+    u8 curr_Tap:8;              /* store current Wiper tap value */
+    u8 tapVal:8;                /* store required output Wiper tap value*/
+    bool cs:1;                  /* chip select input */
+    bool updwn_ctrl:1;          /* up/down control input */
+    bool MoveDownFlag:1;        /* move down notification */
+    bool MoveUpFlag:1;          /* move up notification */
+    bool inc_ctrl:1;            /* increment control input last written */
+    u8 edges;                   /* INC falling edges of the current move, written by the ISR */
+    u8 stopEdges;               /* edge count the ISR ends the current move at */
+    u8 startTap;                /* wiper tap the current move started from */
+    Sig_states STATE;           /* state indication */
+}dualPot[DUALPOT_CH_QUAN];
+#pragma pack(pop)
+
+#define POT(idx, field)     (dualPot[(idx)].field)
+
+#elif (DUALPOT_LAYOUT == DUALPOT_LAYOUT_ALIGNED)
+/* Aligned layout: one naturally aligned record per channel, one byte per flag.
+ * Flag updates are plain byte stores */
+SyncLocal struct DigiPot{
+    Sig_states STATE;           /* state indication */
+    u8 channel;                 /* Channel indication */
+    u8 curr_Tap;                /* store current Wiper tap value */
+    u8 tapVal;                  /* store required output Wiper tap value*/
+    bool cs;                    /* chip select input */
+    bool updwn_ctrl;            /* up/down control input */
+    bool MoveDownFlag;          /* move down notification */
+    bool MoveUpFlag;            /* move up notification */
+    bool inc_ctrl;              /* increment control input last written */
+    u8 edges;                   /* INC falling edges of the current move, written by the ISR */
+    u8 stopEdges;               /* edge count the ISR ends the current move at */
+    u8 startTap;                /* wiper tap the current move started from */
+}dualPot[DUALPOT_CH_QUAN];
+
+#define POT(idx, field)     (dualPot[(idx)].field)
+
+#elif (DUALPOT_LAYOUT == DUALPOT_LAYOUT_SOA)
+/* Struct-of-arrays layout: each field of all channels sits contiguously,
+ * so the per-tick scan over STATE/channel touches a single cache line */
+SyncLocal struct DigiPot{
+    u8 STATE[DUALPOT_CH_QUAN];          /* state indication (Sig_states) */
+    u8 channel[DUALPOT_CH_QUAN];        /* Channel indication */
+    u8 curr_Tap[DUALPOT_CH_QUAN];       /* store current Wiper tap value */
+    u8 tapVal[DUALPOT_CH_QUAN];         /* store required output Wiper tap value*/
+    bool cs[DUALPOT_CH_QUAN];           /* chip select input */
+    bool updwn_ctrl[DUALPOT_CH_QUAN];   /* up/down control input */
+    bool MoveDownFlag[DUALPOT_CH_QUAN]; /* move down notification */
+    bool MoveUpFlag[DUALPOT_CH_QUAN];   /* move up notification */
+    bool inc_ctrl[DUALPOT_CH_QUAN];     /* increment control input last written */
+    u8 edges[DUALPOT_CH_QUAN];          /* INC falling edges of the current move, written by the ISR */
+    u8 stopEdges[DUALPOT_CH_QUAN];      /* edge count the ISR ends the current move at */
+    u8 startTap[DUALPOT_CH_QUAN];       /* wiper tap the current move started from */
+}dualPot;
+
+#define POT(idx, field)     (dualPot.field[(idx)])
+
+#else
+#error "DUALPOT_LAYOUT: unsupported channel state layout"
+#endif
+
+/* Pin assignment per channel, indexed like dualPot */
+static const PinT pinCS[DUALPOT_CH_QUAN]  = {PinCSA,  PinCSB};
+static const PinT pinUD[DUALPOT_CH_QUAN]  = {PinUDA,  PinUDB};
+static const PinT pinINC[DUALPOT_CH_QUAN] = {PinINCA, PinINCB};
+
+SyncLocal bool incr_ctrl; /* Wiper increment control phase, shared by all channels*/
+SyncLocal bool updwn50usFlag; /* Control 50us timer elapse*/
+static SyncLocal bool timerRun; /* timer started by timerStart and not yet stopped */
+static SyncLocal bool timerUp;  /* timer configured by timerStart, until DeInit */
+static SyncLocal u32 tickCount; /* handler invocations since init */
+static SyncLocal u32 stopTick[DUALPOT_CH_QUAN]; /* tick the ISR stopped each channel on */
+static SyncLocal u32 holdTick[DUALPOT_CH_QUAN]; /* tick U/D changed or INC rose on, no INC fall in it */
+
+/* step rate after overruns, ISR only */
+static SyncLocal u32 stride;    /* ticks per ISR step, above 1 after overruns */
+static SyncLocal u32 strideSkip; /* ticks to skip before the next step */
+#ifdef PERIODIC_ROLLOVERS
+static SyncLocal u32 rollSeen;  /* timer rollovers at the last handler call */
+static SyncLocal u32 rollOverrun; /* timer rollovers at the last overrun */
+static SyncLocal u32 strideCalm; /* ticks since the last overrun or halving, while stride > 1 */
+static SyncLocal bool strideStepped; /* the last handler call stepped */
+#else
+#define strideCalm  0U          /* overruns go unnoticed, the stride stays 1 */
+#endif
+
+/* Odd while the ISR replans a move: startTap, edges and updwn_ctrl change together */
+static SyncLocal u32 moveSeq[DUALPOT_CH_QUAN];
+
+/* Status snapshot handoff while the timer runs */
+static SyncLocal u32 isrBusy;       /* odd while the ISR may publish, ISR only */
+static SyncLocal bool statusDirty;  /* the ISR changed the status this tick, ISR only */
+static SyncLocal u32 statusSeen;    /* statusAsk at the last ISR publish, ISR only */
+static SyncLocal u32 statusAsk;     /* changes for the ISR to publish, bottom half only */
+static SyncLocal bool statusStale;  /* the bottom half changed the status, bottom half only */
+
+/* Command slot per channel, two commands: the bottom half writes the one
+ * cmdSeq does not select and publishes it by advancing cmdSeq with one
+ * store; the ISR takes the selected one and acknowledges it in cmdTaken */
+static SyncLocal struct {
+    u8 Tap;                             /* target tap */
+    u8 Resync;                          /* 1: through the nearer end stop, full scale */
+} cmdSlot[DUALPOT_CH_QUAN][2];
+static SyncLocal u32 cmdSeq[DUALPOT_CH_QUAN];      /* commands published, bottom half */
+static SyncLocal u32 cmdTaken[DUALPOT_CH_QUAN];    /* commands taken, ISR */
+
+/* End stop resync per channel, ISR only: while On the move under way runs
+ * into an end stop, from where the channel continues to Tap */
+static SyncLocal struct {
+    u8 On;                              /* driving into the end stop */
+    u8 Tap;                             /* target behind the end stop */
+    u32 Pulses;                         /* INC falling edges since the last end stop */
+} resync[DUALPOT_CH_QUAN];
+
+/* Trajectory per channel: two chunks of setpoints, the ISR plays one while
+ * the bottom half refills the other. Full hands a chunk over in each direction */
+static SyncLocal struct {
+    u8 Tap[2][DUALPOT_TRAJ_CHUNK];      /* setpoints */
+    u32 Ticks[2][DUALPOT_TRAJ_CHUNK];   /* ticks each setpoint is held */
+    u32 Quan[2];                        /* points in the chunk */
+    u8 Full[2];                         /* chunk queued: set by the bottom half, cleared by the ISR */
+    u8 On;                              /* trajectory mode, bottom half */
+    u8 Starved;                         /* a point was due and none queued, ISR */
+    u8 Played;                          /* a point was played since the start, ISR */
+    u8 Play;                            /* chunk playing, ISR */
+    u8 Fill;                            /* chunk queued next, bottom half */
+    u32 Point;                          /* next point of the playing chunk, ISR */
+    u32 Wait;                           /* ticks until the next point, ISR */
+} traj[DUALPOT_CH_QUAN];
+
+/* Channel order of the ISR, built by the bottom half into the half
+ * schedSel does not select and switched to with one store */
+static SyncLocal u8 schedOrder[2][DUALPOT_CH_QUAN];
+static SyncLocal u8 schedSel;
+
+/* Deadline of the current move per channel, bottom half only */
+static SyncLocal bool dueSet[DUALPOT_CH_QUAN]; /* the move has a deadline */
+static SyncLocal u32 dueTick[DUALPOT_CH_QUAN]; /* last tick the move may stop on */
+
+/* Bottom half bookkeeping per channel, never written by the ISR; it
+ * reads late for the status snapshot */
+static SyncLocal struct {
+    bool doneSent;              /* completion of the current move reported */
+    bool late;                  /* the current move missed its deadline */
+#if DUALPOT_STATS
+    u8 lastState;               /* state StateTicks are accumulated for */
+    u32 lastTick;               /* first tick counted for lastState */
+    u32 pulsesSeen;             /* isrPulses already counted in IncPulses */
+    u32 reversalsSeen;          /* isrReversals already counted in Reversals */
+    u32 resyncsSeen;            /* isrResyncs already counted in Resyncs */
+#endif
+} deferCh[DUALPOT_CH_QUAN];
+
+#if DUALPOT_STATS
+/* State changes made by the ISR, single producer/single consumer ring
+ * emptied by the bottom half; a full ring drops events (EventsLost) */
+#define EVENT_QUAN 16U          /* power of two */
+
+typedef struct {
+    u32 Tick;                   /* tick the state was entered on */
+    u8 Idx;                     /* channel index */
+    u8 State;                   /* Sig_states entered */
+} isrEventT;
+
+static SyncLocal isrEventT eventBuf[EVENT_QUAN];
+static SyncLocal u32 eventHead; /* events written, ISR only */
+static SyncLocal u32 eventTail; /* events consumed, bottom half only */
+static SyncLocal u32 tickSeen;  /* tickCount folded into IsrCount */
+static SyncLocal u32 isrOverruns; /* handler calls after lost rollovers, ISR only */
+static SyncLocal u32 isrSkipped; /* handler calls without a step, ISR only */
+static SyncLocal u32 overrunsSeen; /* isrOverruns folded into IsrOverruns */
+static SyncLocal u32 skippedSeen; /* isrSkipped folded into IsrSkipped */
+
+static SyncLocal u32 isrPulses[DUALPOT_CH_QUAN]; /* INC falling edges, ISR only */
+static SyncLocal u32 isrReversals[DUALPOT_CH_QUAN]; /* U/D changes of trajectory moves, ISR only */
+static SyncLocal u32 isrResyncs[DUALPOT_CH_QUAN]; /* end stop resyncs started, ISR only */
+#endif
+
+/* Copy of the channel states the settle prediction replays the ISR on */
+typedef struct {
+    u8 State[DUALPOT_CH_QUAN];          /* Sig_states */
+    bool Cs[DUALPOT_CH_QUAN];           /* chip select level */
+    bool Inc[DUALPOT_CH_QUAN];          /* increment control level */
+    bool Up[DUALPOT_CH_QUAN];           /* U/D direction of the move */
+    bool Hold[DUALPOT_CH_QUAN];         /* no INC fall this tick, holdTick */
+    u8 Edges[DUALPOT_CH_QUAN];          /* falling edges issued */
+    u8 StopEdges[DUALPOT_CH_QUAN];      /* edge count the move ends at */
+    u8 StartTap[DUALPOT_CH_QUAN];       /* tap the move started from */
+    u8 ResyncOn[DUALPOT_CH_QUAN];       /* resync On */
+    u8 ResyncTap[DUALPOT_CH_QUAN];      /* resync Tap */
+    u32 Pulses[DUALPOT_CH_QUAN];        /* resync Pulses */
+    u8 Order[DUALPOT_CH_QUAN];          /* schedOrder in use */
+    bool Flag;                          /* updwn50usFlag */
+    bool Incr;                          /* incr_ctrl */
+    bool Run;                           /* timerRun */
+    u32 Stride;                         /* stride */
+    u32 Skip;                           /* strideSkip */
+    u32 Calm;                           /* strideCalm */
+} settleModelT;
+
+/******************************************************************************
+ *	local functions
+ ******************************************************************************/
+static void max5389Init(const DualPotWarmT *warm);
+static bool max5389Main(u8 channel, u8 tap, u32 deadline);
+static void max5389DeInit(DualPotWarmT *warm);
+static void max5389Deferred(void);
+static void max5389Settle(u8 channel, const f32 *resistance, DualPotSettleT *settle, size_t n);
+static bool max5389TrajStart(u8 channel);
+static size_t max5389TrajQueue(u8 channel, const u8 *tap, const u32 *ticks, size_t n);
+static void max5389TrajStop(u8 channel);
+static bool max5389Resync(u8 channel);
+static void trajService(void);
+static u32 trajTick(u8 idx);
+static u32 trajRetarget(u8 idx, u8 tap);
+static void timerStart(void);
+static bool strideTake(void);
+static void settleTick(settleModelT *model);
+static void settleBegin(settleModelT *model, u8 idx, u8 cur, u8 tap);
+static void settleResync(settleModelT *model, u8 idx, u8 cur, u8 tap, u8 pulses);
+static void settleRequest(settleModelT *model, u8 idx, u8 tap, u8 full);
+static u32 setWiper(u8 idx, u32 budget);
+static void cmdPublish(u8 idx, u8 tap, u8 full);
+static bool cmdPending(u8 idx);
+static void cmdTake(u8 idx);
+static void cmdApply(u8 idx, u8 tap, u8 full);
+static void beginMove(u8 idx, u8 cur, u8 tap);
+static void resyncBegin(u8 idx, u8 cur, u8 tap, u8 pulses);
+static bool resyncEnd(u8 idx);
+static u8 resyncPulses(u8 cur);
+static void publishStatus(void);
+static void statusUpdate(void);
+static void drainIsr(void);
+static void syncTap(u8 idx);
+static void completeMoves(void);
+static bool idleCheck(void);
+static void stateSet(u8 idx, Sig_states state);
+static void deadlineSet(u8 idx, u32 deadline);
+static void schedUpdate(void);
+static void schedBuild(u8 *order, const bool *set, const u32 *due);
+#if DUALPOT_STATS
+static void logEvent(u8 idx, Sig_states state);
+static void stateTicksAdd(u8 idx, u32 tick, u8 state);
+#endif
+
+void ISR_Timer25us_Handler(void);
+
+/******************************************************************************
+ *	local macros
+ ******************************************************************************/
+#define CH_NUM(idx)     ((u8)((idx) + chA))     /* channel notation of a channel index */
+
+#if DUALPOT_STATS
+#define LOG_EVENT(idx, state)   logEvent((idx), (state))
+#else
+#define LOG_EVENT(idx, state)
+#endif
+
+/* tick a lies after tick b, ticks are numbered modulo 2^32 */
+#define TICK_AFTER(a, b)    ((u32)((a) - (b) - 1U) < 0x7FFFFFFFUL)
+
+#if (0 == DUALPOT_PIN_BUDGET)
+#define PIN_BUDGET      0xFFFFFFFFUL            /* no limit */
+#elif (2 > DUALPOT_PIN_BUDGET)
+#error "DUALPOT_PIN_BUDGET: ending a move takes two pin writes in one tick"
+#else
+#define PIN_BUDGET      ((u32)DUALPOT_PIN_BUDGET)
+#endif
+
+/* pulses since the last end stop that make the next move from rest a resync */
+#if (0 == DUALPOT_RESYNC_PULSES)
+#define RESYNC_DUE(pulses)  (False)
+#else
+#define RESYNC_DUE(pulses)  ((pulses) >= (u32)DUALPOT_RESYNC_PULSES)
+#endif
+
+#if (1 > DUALPOT_STRIDE_MAX) || (1 > DUALPOT_STRIDE_CALM) || (1 > DUALPOT_STRIDE_BURST)
+#error "DUALPOT_STRIDE_MAX/DUALPOT_STRIDE_CALM/DUALPOT_STRIDE_BURST: at least one"
+#endif
+#define STRIDE_MAX      ((u32)DUALPOT_STRIDE_MAX)
+#define STRIDE_CALM     ((u32)DUALPOT_STRIDE_CALM)
+#define STRIDE_BURST    ((u32)DUALPOT_STRIDE_BURST)
+
+#if (1 > DUALPOT_RESYNC_MARGIN)
+#error "DUALPOT_RESYNC_MARGIN: a resync has to cover the pulses possibly missed"
+#endif
+
+/* end stop nearer a tap */
+#define RESYNC_END(tap)     (((tap) <= (u8)(FULL_TAP - (tap))) ? (u8)MIN_TAP : (u8)FULL_TAP)
+
+/******************************************************************************
+ *	device operations
+ ******************************************************************************/
+const DualPotDevT DualPotDev_Max5389 = {
+    max5389Init,
+    max5389Main,
+    max5389DeInit,
+    max5389Deferred,
+    max5389Settle,
+    max5389TrajStart,
+    max5389TrajQueue,
+    max5389TrajStop,
+    max5389Resync
+};
+
+/********************************************************************
+* FUNCTION   : static void max5389Init(const DualPotWarmT *warm)
+* PURPOSE    : Initialize MAX5389 device
+* PARAMETERS : const DualPotWarmT *warm //checked state of the last run, 0 for a cold start
+* RETURN     : void
+* NOTE       : warm, the wipers are taken to be where the last run left
+*              them; the first move needs no resync and no extra pulse.
+*              The timer is left alone until timerStart needs it
+**********************************************************************/
+static void max5389Init(const DualPotWarmT *warm){
+    u32 mask = 0UL;             /* pins of every channel */
+    u32 level = 0UL;            /* their idle levels */
+    u8 idx;
+    u8 tap;
+
+    if(True == timerUp){
+        /* initialized again without DeInit, the next move configures it anew */
+        PeriodicIruptDisable();
+        PeriodicStop();
+        timerUp = False;
+    }/*ELSE: Do nothing*/
+
+    PinModuleInit();            /* Initialize pin module */
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+
+        /* no channel requested yet */
+        POT(idx, channel) = 0U;
+
+        /* Initialize tap value to 128 at power-up, or where the last run left it */
+        tap = MID_TAP;
+        if(0 != warm){
+            tap = warm->Tap[idx];
+        }/*ELSE: Do nothing*/
+        POT(idx, curr_Tap) = tap;
+        POT(idx, tapVal) = tap;
+
+        /* Initialize move up and move down flags */
+        POT(idx, MoveUpFlag) = False;
+        POT(idx, MoveDownFlag) = False;
+
+        /* Initialize signal state */
+        POT(idx, STATE) = Initial;
+
+        /* no move planned yet */
+        POT(idx, edges) = 0U;
+        POT(idx, stopEdges) = 0U;
+        POT(idx, startTap) = tap;
+        moveSeq[idx] = 0U;
+        cmdSeq[idx] = 0U;
+        cmdTaken[idx] = 0U;
+        traj[idx].Full[0] = 0U;
+        traj[idx].Full[1] = 0U;
+        traj[idx].On = 0U;
+        resync[idx].On = 0U;
+        resync[idx].Tap = tap;
+        resync[idx].Pulses = 0U;
+        if(0 != warm){
+            resync[idx].Pulses = warm->Pulses[idx];
+        }/*ELSE: Do nothing*/
+        deferCh[idx].doneSent = False;
+        deferCh[idx].late = False;
+        dueSet[idx] = False;
+        dueTick[idx] = 0U;
+        stopTick[idx] = 0U;
+        holdTick[idx] = 0U;
+#if DUALPOT_STATS
+        deferCh[idx].lastState = (u8)Initial;
+        deferCh[idx].lastTick = 1U;
+        deferCh[idx].pulsesSeen = 0U;
+        deferCh[idx].reversalsSeen = 0U;
+        deferCh[idx].resyncsSeen = 0U;
+        isrPulses[idx] = 0U;
+        isrReversals[idx] = 0U;
+        isrResyncs[idx] = 0U;
+#endif
+    }
+
+    /* Initialize 50us timer flag */
+    updwn50usFlag = False;
+    timerRun = False;
+    tickCount = 0U;
+    stride = 1U;
+    strideSkip = 0U;
+#ifdef PERIODIC_ROLLOVERS
+    strideCalm = 0U;
+    strideStepped = False;
+#endif
+    schedSel = 0U;
+    schedBuild(schedOrder[0], dueSet, dueTick);
+#if DUALPOT_STATS
+    eventHead = 0U;
+    eventTail = 0U;
+    tickSeen = 0U;
+    isrOverruns = 0U;
+    isrSkipped = 0U;
+    overrunsSeen = 0U;
+    skippedSeen = 0U;
+#endif
+
+    /* Initialize chip select, increment control and Up/Down control signal
+     * for every channel, U/D in the direction of the last move on a warm start */
+    incr_ctrl = True;                    /* Initialize increment control variable */
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        POT(idx, cs) = True;
+        POT(idx, inc_ctrl) = True;
+        POT(idx, updwn_ctrl) = False;
+        if(0 != warm){
+            POT(idx, updwn_ctrl) = (bool)(0U != warm->Up[idx]);
+        }/*ELSE: Do nothing*/
+
+        mask |= (1UL << pinCS[idx]) | (1UL << pinUD[idx]) | (1UL << pinINC[idx]);
+        level |= (1UL << pinCS[idx]) | (1UL << pinINC[idx]);
+        if(True == POT(idx, updwn_ctrl)){
+            level |= (1UL << pinUD[idx]);
+        }/*ELSE: Do nothing*/
+    }
+
+    PinWriteMask(mask, level);            /* one port write for all channels */
+    PinFlush();
+    publishStatus();
+}
+
+/********************************************************************
+* FUNCTION   : static bool max5389Main(u8 channel, u8 tap, u32 deadline)
+* PURPOSE    : Move towards the requested tap, poll for completion
+* PARAMETERS : u8 channel           //channel for tap setting, already range checked
+*              u8 tap               //desired tap value
+*              u32 deadline         //ticks from now the move is due in, 0 for none
+* RETURN     : bool                 //True once no channel is moving
+* NOTE       : writes nothing the ISR writes; the target goes through the
+*              command slot and the ISR plans the move at its next tick
+**********************************************************************/
+static bool max5389Main(u8 channel, u8 tap, u32 deadline) {
+
+    bool retVal = False;                    /* return value */
+    bool wasTraj = False;                   /* the request ended a trajectory */
+    u8 idx;
+
+    idx = (u8)(channel - chA);
+    if(0U != traj[idx].On){
+        max5389TrajStop(channel);           /* a request ends the trajectory */
+        wasTraj = True;
+    }/*ELSE: Do nothing*/
+
+    drainIsr();                             /* current tap of every channel */
+    completeMoves();                        /* moves finished before this request */
+
+    /* a new target or an idle channel takes the deadline, polls keep theirs */
+    if((tap != POT(idx, tapVal)) || (Initial == POT(idx, STATE)) || (Stop == POT(idx, STATE))){
+        deadlineSet(idx, deadline);
+    }/*ELSE: Do nothing*/
+
+    POT(idx, tapVal) = tap;                     /* store requested tap value */
+    statusStale = True;
+
+    if((False == wasTraj) && (False == cmdPending(idx)) &&
+       ((Initial == POT(idx, STATE)) || (Stop == POT(idx, STATE))) && (tap == POT(idx, curr_Tap))){
+        /* idle channel already at the tap: no move, the ISR leaves it alone */
+        POT(idx, channel) = channel;
+        POT(idx, MoveDownFlag) = False;         /* reset move up or move down flag */
+        POT(idx, MoveUpFlag) = False;
+        if(Initial == POT(idx, STATE)){
+            deferCh[idx].doneSent = True;       /* no move, nothing to report */
+        }/*ELSE: Do nothing, a finished move may still be unreported*/
+        stateSet(idx, Stop);                    /* change signal state to Stop */
+    }else{
+        /* the ISR plans the move from where the wiper is; a resync not
+         * taken yet stays one */
+        cmdPublish(idx, tap, (u8)((True == cmdPending(idx)) ? cmdSlot[idx][cmdSeq[idx] & 1U].Resync : 0U));
+        timerStart();
+    }
+
+    trajService();                            /* refill the trajectories of the other channels */
+
+    /* if desired tap value is achieved on every requested channel return success else fail */
+    completeMoves();
+    retVal = idleCheck();
+    statusUpdate();
+    return retVal;
+}
+
+/********************************************************************
+* FUNCTION   : static void max5389DeInit(DualPotWarmT *warm)
+* PURPOSE    : De-initialize MAX5389 device
+* PARAMETERS : DualPotWarmT *warm   //state export, 0 for none
+* RETURN     : void
+* NOTE       : the timer stops first, a moving channel stays at the tap of
+*              the edges issued; a resync under way leaves the tap unsure,
+*              exported so that the next run resyncs on its first move
+**********************************************************************/
+static void max5389DeInit(DualPotWarmT *warm){
+    u32 mask = 0UL;                         /* pins of every channel */
+    u32 level = 0UL;                        /* their reset levels, U/D low */
+    u8 idx;
+
+    if(True == timerUp){
+        PeriodicIruptDisable();             /* the ISR is not running on return */
+        PeriodicStop();
+        timerUp = False;
+    }/*ELSE: Do nothing*/
+    timerRun = False;
+    drainIsr();                             /* tap of the edges issued */
+
+    if(0 != warm){
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            warm->Tap[idx] = POT(idx, curr_Tap);
+            warm->Up[idx] = (u8)POT(idx, updwn_ctrl);
+            warm->Pulses[idx] = resync[idx].Pulses;
+            if(0U != resync[idx].On){
+                warm->Pulses[idx] = 0xFFFFFFFFUL;
+            }/*ELSE: Do nothing*/
+        }
+    }/*ELSE: Do nothing*/
+
+    /* Reset chip select, Up/Down and increment control signal for every channel */
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        mask |= (1UL << pinCS[idx]) | (1UL << pinUD[idx]) | (1UL << pinINC[idx]);
+        level |= (1UL << pinCS[idx]) | (1UL << pinINC[idx]);
+    }
+    PinWriteMask(mask, level);
+    PinFlush();
+}
+
+/********************************************************************
+* FUNCTION   : static void max5389Deferred(void)
+* PURPOSE    : Bottom half, catch up with the ISR
+* PARAMETERS : void
+* RETURN     : void
+* NOTE       : called from the main loop or a low priority interrupt,
+*              never from ISR_Timer25us_Handler
+**********************************************************************/
+static void max5389Deferred(void){
+
+    drainIsr();
+    trajService();
+    completeMoves();
+    (void)idleCheck();
+    statusUpdate();
+}
+
+/********************************************************************
+* FUNCTION   : static void max5389Settle(u8 channel, const f32 *resistance, DualPotSettleT *settle, size_t n)
+* PURPOSE    : Predict the ticks each move of a setpoint sequence takes
+* PARAMETERS : u8 channel           //channel for tap setting, already range checked
+*              const f32 *resistance    //range checked setpoints, in request order
+*              DualPotSettleT *settle   //Ticks from each request to its Stop
+*              size_t n             //number of setpoints
+* RETURN     : void
+* NOTE       : replays the ISR on a copy of the channel states and the
+*              commands it has still to take, so the result is exact for
+*              the current state unless a trajectory retargets a channel
+*              or the ISR overruns meanwhile. Every setpoint after
+*              the first is taken as requested right after the previous one
+*              stopped, with the timer stopped if no other channel moves.
+**********************************************************************/
+static void max5389Settle(u8 channel, const f32 *resistance, DualPotSettleT *settle, size_t n){
+    settleModelT model;
+    u8 self = (u8)(channel - chA);          /* index of the requested channel */
+    bool set[DUALPOT_CH_QUAN];              /* dueSet after each request */
+    u8 reqTap = POT(self, tapVal);          /* tapVal after each request */
+    u8 target;
+    u8 full;
+    u8 idx;
+    size_t i;
+    u32 count;
+
+    /* copy of the live state, the ISR may run on while it is taken */
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        model.State[idx] = (u8)POT(idx, STATE);
+        model.Cs[idx] = POT(idx, cs);
+        model.Inc[idx] = POT(idx, inc_ctrl);
+        model.Up[idx] = POT(idx, updwn_ctrl);
+        model.Hold[idx] = False;
+        model.Edges[idx] = SyncLoad(&POT(idx, edges));
+        model.StopEdges[idx] = SyncLoadRelaxed(&POT(idx, stopEdges));
+        model.StartTap[idx] = POT(idx, startTap);
+        model.ResyncOn[idx] = SyncLoadRelaxed(&resync[idx].On);
+        model.ResyncTap[idx] = SyncLoadRelaxed(&resync[idx].Tap);
+        model.Pulses[idx] = SyncLoadRelaxed(&resync[idx].Pulses);
+        set[idx] = dueSet[idx];
+    }
+    model.Flag = updwn50usFlag;
+    model.Incr = incr_ctrl;
+    model.Run = timerRun;
+    model.Stride = stride;
+    model.Skip = strideSkip;
+    model.Calm = strideCalm;
+
+    /* commands for the other channels the ISR has not taken yet, it takes
+     * them at its next step together with the request */
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if((self != idx) && (True == cmdPending(idx))){
+            settleRequest(&model, idx, cmdSlot[idx][cmdSeq[idx] & 1U].Tap, cmdSlot[idx][cmdSeq[idx] & 1U].Resync);
+        }/*ELSE: Do nothing*/
+    }
+
+    for(i = 0U; i < n; i++){
+        target = DUALPOT_TAP(resistance[i]);
+
+        /* the request, as max5389Main publishes it; it carries no deadline,
+         * so a new target drops the channel behind those with one. A resync
+         * not taken yet stays one */
+        if((target != reqTap) || (Initial == model.State[self]) || (Stop == model.State[self])){
+            set[self] = False;
+        }/*ELSE: Do nothing*/
+        reqTap = target;
+        schedBuild(model.Order, set, dueTick);
+
+        full = 0U;
+        if((0U == i) && (True == cmdPending(self))){
+            full = cmdSlot[self][cmdSeq[self] & 1U].Resync;
+        }/*ELSE: Do nothing*/
+        settleRequest(&model, self, target, full);
+        if((Stop != model.State[self]) && (False == model.Run)){
+            model.Incr = True;
+            model.Flag = False;
+            model.Skip = 0U;
+            model.Run = True;
+        }/*ELSE: Do nothing*/
+
+        /* ticks until the ISR stops the channel */
+        count = 0U;
+        while(Stop != model.State[self]){
+            settleTick(&model);
+            count++;
+        }
+        settle[i].Ticks = count;
+
+        /* max5389Main stops the timer once the move is seen complete and nothing else moves */
+        model.Run = False;
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            if((Initial != model.State[idx]) && (Stop != model.State[idx])){
+                model.Run = True;
+            }
+        }
+    }
+}
+
+/********************************************************************
+* FUNCTION   : static bool max5389TrajStart(u8 channel)
+* PURPOSE    : Hand the channel over to the timer for a trajectory
+* PARAMETERS : u8 channel           //channel for the trajectory, already range checked
+* RETURN     : bool                 //always True
+* NOTE       : a trajectory already playing on the channel is dropped
+**********************************************************************/
+static bool max5389TrajStart(u8 channel){
+    u8 idx = (u8)(channel - chA);
+
+    SyncStore(&traj[idx].On, 0U);           /* the ISR leaves the queue alone */
+    drainIsr();
+    completeMoves();                        /* report a move finished before */
+    deadlineSet(idx, 0U);
+
+    traj[idx].Full[0] = 0U;
+    traj[idx].Full[1] = 0U;
+    traj[idx].Starved = 0U;
+    traj[idx].Played = 0U;
+    traj[idx].Play = 0U;
+    traj[idx].Fill = 0U;
+    traj[idx].Point = 0U;
+    traj[idx].Wait = 0U;
+
+    POT(idx, channel) = channel;
+    SyncStore(&traj[idx].On, 1U);
+    timerStart();
+    return True;
+}
+
+/********************************************************************
+* FUNCTION   : static size_t max5389TrajQueue(u8 channel, const u8 *tap, const u32 *ticks, size_t n)
+* PURPOSE    : Queue trajectory points into the chunks the ISR handed back
+* PARAMETERS : u8 channel           //channel in trajectory mode
+*              const u8 *tap        //setpoints
+*              const u32 *ticks     //ticks each setpoint is held, 0 counts as 1
+*              size_t n             //number of points
+* RETURN     : size_t               //points queued, 0 if both chunks are queued
+*                                   //or the channel is not in trajectory mode
+**********************************************************************/
+static size_t max5389TrajQueue(u8 channel, const u8 *tap, const u32 *ticks, size_t n){
+    u8 idx = (u8)(channel - chA);
+    size_t done = 0U;                       /* points queued */
+    u32 quan;                               /* points in the chunk filled */
+    u8 fill;
+
+    while((0U != traj[idx].On) && (done < n) && (0U == SyncLoad(&traj[idx].Full[traj[idx].Fill]))){
+        fill = traj[idx].Fill;
+        for(quan = 0U; (quan < DUALPOT_TRAJ_CHUNK) && (done < n); quan++){
+            traj[idx].Tap[fill][quan] = tap[done];
+            traj[idx].Ticks[fill][quan] = ticks[done];
+            if(0U == ticks[done]){
+                traj[idx].Ticks[fill][quan] = 1U;
+            }/*ELSE: Do nothing*/
+            done++;
+        }
+        traj[idx].Quan[fill] = quan;
+        SyncStore(&traj[idx].Full[fill], 1U);     /* the chunk is complete before the ISR sees it */
+        traj[idx].Fill = (u8)(1U - fill);
+    }
+    return done;
+}
+
+/********************************************************************
+* FUNCTION   : static void max5389TrajStop(u8 channel)
+* PURPOSE    : Take the channel back from the timer
+* PARAMETERS : u8 channel           //channel in trajectory mode
+* RETURN     : void
+* NOTE       : the move under way completes and is reported like a
+*              DualPotDrv_Main move
+**********************************************************************/
+static void max5389TrajStop(u8 channel){
+    u8 idx = (u8)(channel - chA);
+
+    if(0U != traj[idx].On){
+        SyncStore(&traj[idx].On, 0U);
+        deferCh[idx].doneSent = False;
+    }/*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : static bool max5389Resync(u8 channel)
+* PURPOSE    : Resynchronize the wiper through the nearer end stop
+* PARAMETERS : u8 channel           //channel to resync, already range checked
+* RETURN     : bool                 //always True, the timer runs the resync
+* NOTE       : full scale pulses into the end stop, so any wiper position
+*              is covered; the channel then goes on to the tap last
+*              requested, the completion is reported like a
+*              DualPotDrv_Main move
+**********************************************************************/
+static bool max5389Resync(u8 channel){
+    u8 idx = (u8)(channel - chA);
+
+    max5389TrajStop(channel);               /* the resync ends a trajectory */
+    drainIsr();
+    completeMoves();                        /* report a move finished before */
+    deadlineSet(idx, 0U);
+
+    cmdPublish(idx, POT(idx, tapVal), 1U);
+    timerStart();
+    return True;
+}
+
+/********************************************************************
+* FUNCTION   : static void trajService(void)
+* PURPOSE    : Refill the trajectory chunks played, end the trajectories run dry
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+static void trajService(void){
+    bool more;                              /* the producer may have more points */
+    u8 idx;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if(0U != traj[idx].On){
+            more = True;
+            while((True == more) && (0U == SyncLoad(&traj[idx].Full[traj[idx].Fill]))){
+                if(0U == DualPotTraj_Refill(CH_NUM(idx))){
+                    more = False;
+                }/*ELSE: Do nothing*/
+            }
+
+            /* last point held for its ticks and nothing queued: the trajectory ends there */
+            if((0U != SyncLoad(&traj[idx].Starved)) &&
+               (0U == SyncLoad(&traj[idx].Full[0])) && (0U == SyncLoad(&traj[idx].Full[1]))){
+                max5389TrajStop(CH_NUM(idx));
+            }/*ELSE: Do nothing*/
+        }
+    }
+}
+
+/********************************************************************
+* FUNCTION   : static void settleTick(settleModelT *model)
+* PURPOSE    : One ISR_Timer25us_Handler tick on the settle model
+* PARAMETERS : settleModelT *model  //channel states to advance
+* RETURN     : void
+**********************************************************************/
+static void settleTick(settleModelT *model){
+    bool udTick = model->Flag;
+    bool toggle = False;
+    u32 budget = PIN_BUDGET;
+    u8 idx;
+    u8 cur;
+    u8 k;
+
+    /* strideTake without overruns */
+    if(1U < model->Stride){
+        model->Calm++;
+        if(STRIDE_CALM <= model->Calm){
+            model->Stride /= 2U;
+            model->Calm = 0U;
+        }/*ELSE: Do nothing*/
+    }/*ELSE: Do nothing*/
+    if(0U != model->Skip){
+        model->Skip--;
+        return;
+    }/*ELSE: Do nothing*/
+    model->Skip = model->Stride - 1U;
+
+    model->Flag = (bool)!model->Flag;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if((Setup2 == model->State[idx]) || (Running == model->State[idx]) ||
+           ((True == udTick) && (Setup1 == model->State[idx]) && (False == model->Cs[idx]) &&
+            (False == model->Hold[idx]))){
+            toggle = True;
+        }
+    }
+    if(True == toggle){
+        model->Incr = (bool)!model->Incr;
+    }
+
+    for(k = 0U; k < DUALPOT_CH_QUAN; k++){
+        idx = model->Order[k];
+        if((Setup1 == model->State[idx]) && (0U < budget)){
+            if(True == udTick){
+                if((False == model->Cs[idx]) && (False == model->Hold[idx])){
+                    model->State[idx] = (u8)Setup2;
+                    budget--;
+                }
+            }else{
+                if(True == model->Cs[idx]){
+                    model->Cs[idx] = False;
+                    budget--;
+                }
+            }
+        }
+        if((True == toggle) && ((Setup2 == model->State[idx]) || (Running == model->State[idx]))){
+            if((model->Edges[idx] >= model->StopEdges[idx]) && (0U != model->ResyncOn[idx])){
+                model->ResyncOn[idx] = 0U;          /* end stop reached, as resyncEnd */
+                model->Pulses[idx] = 0U;
+                cur = (True == model->Up[idx]) ? (u8)FULL_TAP : (u8)MIN_TAP;
+                if(model->ResyncTap[idx] != cur){
+                    settleBegin(model, idx, cur, model->ResyncTap[idx]);
+                }/*ELSE: Do nothing*/
+            }/*ELSE: Do nothing*/
+            if(Setup1 == model->State[idx]){
+                /* Do nothing, on from the end stop */
+            }else if(model->Edges[idx] >= model->StopEdges[idx]){
+                if(2U <= budget){
+                    model->Inc[idx] = True;
+                    model->Cs[idx] = True;
+                    model->State[idx] = (u8)Stop;
+                    budget -= 2U;
+                }
+            }else{
+                if(0U < budget){
+                    if((True == model->Inc[idx]) && (False == model->Incr)){
+                        model->Edges[idx]++;
+                        model->Pulses[idx]++;
+                    }
+                    model->Inc[idx] = model->Incr;
+                    model->State[idx] = (u8)Running;
+                    budget--;
+                }
+            }
+        }
+    }
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        model->Hold[idx] = False;
+    }
+}
+
+/********************************************************************
+* FUNCTION   : static void settleBegin(settleModelT *model, u8 idx, u8 cur, u8 tap)
+* PURPOSE    : beginMove on the settle model
+* PARAMETERS : settleModelT *model  //channel states
+*              u8 idx               //channel index
+*              u8 cur               //tap the wiper is at
+*              u8 tap               //target tap, not cur
+* RETURN     : void
+**********************************************************************/
+static void settleBegin(settleModelT *model, u8 idx, u8 cur, u8 tap){
+    bool up = (bool)(tap > cur);
+
+    model->StartTap[idx] = cur;
+    model->Edges[idx] = 0U;
+    if((up != model->Up[idx]) || (False == model->Inc[idx])){
+        model->Hold[idx] = True;
+    }/*ELSE: Do nothing*/
+    model->Up[idx] = up;
+    if(True == model->Up[idx]){
+        model->StopEdges[idx] = (u8)(tap - cur);
+    }else{
+        model->StopEdges[idx] = (u8)(cur - tap);
+    }
+    model->Inc[idx] = True;
+    model->State[idx] = (u8)Setup1;
+}
+
+/********************************************************************
+* FUNCTION   : static void settleResync(settleModelT *model, u8 idx, u8 cur, u8 tap, u8 pulses)
+* PURPOSE    : resyncBegin on the settle model
+* PARAMETERS : settleModelT *model  //channel states
+*              u8 idx               //channel index
+*              u8 cur               //tap the wiper is believed at
+*              u8 tap               //target behind the end stop
+*              u8 pulses            //pulses into the end stop, 1..FULL_TAP
+* RETURN     : void
+**********************************************************************/
+static void settleResync(settleModelT *model, u8 idx, u8 cur, u8 tap, u8 pulses){
+
+    if(MIN_TAP == RESYNC_END(cur)){
+        settleBegin(model, idx, (u8)(MIN_TAP + pulses), (u8)MIN_TAP);
+    }else{
+        settleBegin(model, idx, (u8)(FULL_TAP - pulses), (u8)FULL_TAP);
+    }
+    model->ResyncOn[idx] = 1U;
+    model->ResyncTap[idx] = tap;
+}
+
+/********************************************************************
+* FUNCTION   : static void settleRequest(settleModelT *model, u8 idx, u8 tap, u8 full)
+* PURPOSE    : cmdApply on the settle model
+* PARAMETERS : settleModelT *model  //channel states
+*              u8 idx               //channel index
+*              u8 tap               //target tap
+*              u8 full              //1: full scale resync on the way
+* RETURN     : void
+**********************************************************************/
+static void settleRequest(settleModelT *model, u8 idx, u8 tap, u8 full){
+    u8 cur;                                 /* tap the wiper is at */
+
+    if(True == model->Up[idx]){
+        cur = (u8)(model->StartTap[idx] + model->Edges[idx]);
+    }else{
+        cur = (u8)(model->StartTap[idx] - model->Edges[idx]);
+    }
+
+    if(0U != full){
+        settleResync(model, idx, cur, tap, (u8)(FULL_TAP - MIN_TAP));
+    }else if(0U != model->ResyncOn[idx]){
+        model->ResyncTap[idx] = tap;            /* on to the new tap from the end stop */
+    }else if((Initial == model->State[idx]) || (Stop == model->State[idx]) ||
+             ((tap > cur) && (False == model->Up[idx])) ||
+             ((tap < cur) && (True == model->Up[idx]))){
+        if(tap == cur){
+            model->State[idx] = (u8)Stop;       /* already there, no move */
+        }else if(((Initial == model->State[idx]) || (Stop == model->State[idx])) &&
+                 RESYNC_DUE(model->Pulses[idx])){
+            settleResync(model, idx, cur, tap, resyncPulses(cur));
+        }else{
+            settleBegin(model, idx, cur, tap);
+        }
+    }else{
+        /* same direction, the move ends at the new tap */
+        if(True == model->Up[idx]){
+            model->StopEdges[idx] = (u8)(tap - model->StartTap[idx]);
+        }else{
+            model->StopEdges[idx] = (u8)(model->StartTap[idx] - tap);
+        }
+    }
+}
+
+/********************************************************************
+* FUNCTION   : static u32 trajTick(u8 idx)
+* PURPOSE    : Play the next trajectory point once the current one was held
+* PARAMETERS : u8 idx               //channel index, trajectory mode
+* RETURN     : u32                  //pin writes issued
+* NOTE       : called from the ISR
+**********************************************************************/
+static u32 trajTick(u8 idx){
+    u32 writes = 0U;                        /* pin writes issued */
+    u8 play = traj[idx].Play;
+
+    if(0U != traj[idx].Wait){
+        traj[idx].Wait--;                   /* current point still held */
+    }
+
+    if(0U == traj[idx].Wait){
+
+        /* chunk played out: hand it back for refilling, go on with the other one */
+        if((0U != SyncLoad(&traj[idx].Full[play])) && (traj[idx].Point >= traj[idx].Quan[play])){
+            SyncStore(&traj[idx].Full[play], 0U);
+            play = (u8)(1U - play);
+            traj[idx].Play = play;
+            traj[idx].Point = 0U;
+        }
+
+        if(0U != SyncLoad(&traj[idx].Full[play])){
+            writes = trajRetarget(idx, traj[idx].Tap[play][traj[idx].Point]);
+            traj[idx].Wait = traj[idx].Ticks[play][traj[idx].Point];
+            traj[idx].Point++;
+            traj[idx].Played = 1U;
+            SyncStoreRelaxed(&traj[idx].Starved, 0U);
+        }else{
+            if(0U != traj[idx].Played){
+                SyncStore(&traj[idx].Starved, 1U);  /* the bottom half refills or ends it */
+            }/*ELSE: Do nothing, no point queued yet*/
+        }
+    }
+    return writes;
+}
+
+/********************************************************************
+* FUNCTION   : static u32 trajRetarget(u8 idx, u8 tap)
+* PURPOSE    : Move the channel on to a new tap from the ISR
+* PARAMETERS : u8 idx               //channel index, trajectory mode
+*              u8 tap               //setpoint due
+* RETURN     : u32                  //pin writes issued
+* NOTE       : the trajectory counterpart of cmdApply: a move
+*              in the same direction ends at the new tap, any other change
+*              plans a new move from the current tap through Setup1; a
+*              resync under way goes on to the setpoint from the end stop
+**********************************************************************/
+static u32 trajRetarget(u8 idx, u8 tap){
+    u32 writes = 0U;                        /* pin writes issued */
+    Sig_states state = (Sig_states)POT(idx, STATE);
+    bool up = POT(idx, updwn_ctrl);
+    u8 start = POT(idx, startTap);
+    u8 cur;                                 /* tap the wiper is at */
+
+    if(True == up){
+        cur = (u8)(start + POT(idx, edges));
+    }else{
+        cur = (u8)(start - POT(idx, edges));
+    }
+    POT(idx, tapVal) = tap;
+    statusDirty = True;
+
+    if(0U != resync[idx].On){
+        SyncStoreRelaxed(&resync[idx].Tap, tap);    /* on to the setpoint from the end stop */
+    }else if(((Setup2 == state) || (Running == state)) &&
+       (((True == up) && (tap >= cur)) || ((False == up) && (tap <= cur)))){
+
+        /* same direction: the move ends at the new tap */
+        if(True == up){
+            SyncStore(&POT(idx, stopEdges), (u8)(tap - start));
+        }else{
+            SyncStore(&POT(idx, stopEdges), (u8)(start - tap));
+        }
+    }else{
+        if((tap != cur) || (Setup1 == state)){
+
+            /* idle, reversing or not moving yet: a new move from the current tap */
+            SyncStoreRelaxed(&moveSeq[idx], moveSeq[idx] + 1U);
+            SyncFenceRelease();             /* odd sequence is visible before the move changes */
+            POT(idx, startTap) = cur;
+            SyncStoreRelaxed(&POT(idx, edges), 0U);
+            if(((tap > cur) && (False == up)) || ((tap < cur) && (True == up))){
+                POT(idx, updwn_ctrl) = (bool)!up;
+                PinWrite(pinUD[idx], POT(idx, updwn_ctrl));     /* settles before the next INC edge */
+                holdTick[idx] = tickCount;
+                DUALPOT_STAT(isrReversals[idx]++);
+                writes++;
+            }/*ELSE: Do nothing*/
+            if(tap > cur){
+                SyncStoreRelaxed(&POT(idx, stopEdges), (u8)(tap - cur));
+            }else{
+                SyncStoreRelaxed(&POT(idx, stopEdges), (u8)(cur - tap));
+            }
+            SyncStore(&moveSeq[idx], moveSeq[idx] + 1U);
+
+            if(Setup1 != state){
+                POT(idx, STATE) = Setup1;           /* chip select drop and U/D next */
+                LOG_EVENT(idx, Setup1);
+            }/*ELSE: Do nothing*/
+        }/*ELSE: Do nothing, already at the tap*/
+    }
+    return writes;
+}
+
+/********************************************************************
+* FUNCTION   : static u32 setWiper(u8 idx, u32 budget)
+* PURPOSE    : Drive increment control, end the move at the planned edge count
+* PARAMETERS : u8 idx               //channel index
+*              u32 budget           //pin writes left this tick
+* RETURN     : u32                  //pin writes left after the channel's
+* NOTE       : called from the ISR after incr_ctrl was inverted
+**********************************************************************/
+static u32 setWiper(u8 idx, u32 budget){
+
+    /* Check if the signal state is Setup2/Running for the channel */
+    if((Setup2 == POT(idx, STATE)) || (Running == POT(idx, STATE))){
+
+        if(POT(idx, edges) >= SyncLoadRelaxed(&POT(idx, stopEdges))){
+
+            /* planned edges issued: return increment control high, deselect the chip,
+             * unless the move ran into an end stop and goes on from there */
+            if(True == resyncEnd(idx)){
+                /* Do nothing, the chip stays selected */
+            }else if(2U <= budget){
+                POT(idx, inc_ctrl) = True;
+                PinWrite(pinINC[idx], POT(idx, inc_ctrl));
+                POT(idx, cs) = True;
+                PinWrite(pinCS[idx], POT(idx, cs));
+                SyncStore(&stopTick[idx], tickCount);
+                POT(idx, STATE) = Stop;             /* change signal state to Stop */
+                LOG_EVENT(idx, Stop);
+                statusDirty = True;
+                budget -= 2U;
+            }/*ELSE: Do nothing, released on a later tick*/
+
+        }else{
+
+            if(0U < budget){
+
+                /* Count the falling edge on increment control signal of the channel,
+                 * each one moves the wiper one tap in the U/D direction */
+                if((True == POT(idx, inc_ctrl)) && (False == incr_ctrl)){
+                    SyncStore(&POT(idx, edges), (u8)(POT(idx, edges) + 1U));
+                    SyncStoreRelaxed(&resync[idx].Pulses, resync[idx].Pulses + 1U);
+                    DUALPOT_STAT(isrPulses[idx]++);
+                    statusDirty = True;
+                }
+
+                /* Writing increment control signal value to the channel's pin */
+                POT(idx, inc_ctrl) = incr_ctrl;
+                PinWrite(pinINC[idx], POT(idx, inc_ctrl));
+                if(Running != POT(idx, STATE)){
+                    POT(idx, STATE) = Running;
+                    LOG_EVENT(idx, Running);
+                    statusDirty = True;
+                }
+                budget--;
+            }/*ELSE: Do nothing, the edge moves to a later tick*/
+        }
+    }
+    return budget;
+}
+
+/********************************************************************
+* FUNCTION   : static void cmdPublish(u8 idx, u8 tap, u8 full)
+* PURPOSE    : Hand a target to the ISR
+* PARAMETERS : u8 idx               //channel index
+*              u8 tap               //target tap
+*              u8 full              //1: full scale resync on the way
+* RETURN     : void
+* NOTE       : bottom half only; a command the ISR has not taken yet is
+*              superseded, the ISR never sees a half written one
+**********************************************************************/
+static void cmdPublish(u8 idx, u8 tap, u8 full){
+    u32 seq = cmdSeq[idx] + 1U;
+
+    SyncFenceRelease();                     /* the last publish is visible before its slot is reused */
+    SyncStoreRelaxed(&cmdSlot[idx][seq & 1U].Tap, tap);
+    SyncStoreRelaxed(&cmdSlot[idx][seq & 1U].Resync, full);
+    SyncStore(&cmdSeq[idx], seq);
+    deferCh[idx].doneSent = False;          /* the command ends in a Stop to report */
+    statusStale = True;                     /* an idle channel shows Setup1 */
+}
+
+/********************************************************************
+* FUNCTION   : static bool cmdPending(u8 idx)
+* PURPOSE    : Check for a command the ISR has not taken yet
+* PARAMETERS : u8 idx               //channel index
+* RETURN     : bool                 //True if the ISR has still to take it
+* NOTE       : bottom half only; once False, the channel state shows the
+*              move planned for the last command
+**********************************************************************/
+static bool cmdPending(u8 idx){
+
+    return (bool)(SyncLoad(&cmdTaken[idx]) != cmdSeq[idx]);
+}
+
+/********************************************************************
+* FUNCTION   : static void cmdTake(u8 idx)
+* PURPOSE    : Take the last command published for the channel
+* PARAMETERS : u8 idx               //channel index
+* RETURN     : void
+* NOTE       : called from the ISR; a command published while the slot is
+*              read is taken on the next tick instead
+**********************************************************************/
+static void cmdTake(u8 idx){
+    u32 seq = SyncLoad(&cmdSeq[idx]);
+    u8 tap;
+    u8 full;
+
+    if(seq != cmdTaken[idx]){
+        tap = SyncLoadRelaxed(&cmdSlot[idx][seq & 1U].Tap);
+        full = SyncLoadRelaxed(&cmdSlot[idx][seq & 1U].Resync);
+        SyncFenceAcquire();                 /* slot read before the sequence is re-read */
+        if(seq == SyncLoadRelaxed(&cmdSeq[idx])){
+            cmdApply(idx, tap, full);
+            SyncStore(&cmdTaken[idx], seq); /* the planned move is visible before the acknowledge */
+            statusDirty = True;
+        }/*ELSE: Do nothing, the slot was reused meanwhile*/
+    }/*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : static void cmdApply(u8 idx, u8 tap, u8 full)
+* PURPOSE    : Move the channel on to a requested tap
+* PARAMETERS : u8 idx               //channel index
+*              u8 tap               //target tap
+*              u8 full              //1: full scale resync on the way
+* RETURN     : void
+* NOTE       : called from the ISR. An idle channel away from the tap and
+*              a moving one that has to reverse get a new move through
+*              Setup1; a move in the same direction ends at the new tap.
+*              An idle channel due for a resync and a full scale request
+*              go through the end stop, a resync under way just takes
+*              the new tap
+**********************************************************************/
+static void cmdApply(u8 idx, u8 tap, u8 full){
+    Sig_states state = (Sig_states)POT(idx, STATE);
+    bool up = POT(idx, updwn_ctrl);
+    u8 start = POT(idx, startTap);
+    u8 cur;                                 /* tap the wiper is at */
+
+    if(True == up){
+        cur = (u8)(start + POT(idx, edges));
+    }else{
+        cur = (u8)(start - POT(idx, edges));
+    }
+    POT(idx, channel) = CH_NUM(idx);
+
+    if(0U != full){
+        resyncBegin(idx, cur, tap, (u8)(FULL_TAP - MIN_TAP));  /* the believed tap may be anything */
+    }else if(0U != resync[idx].On){
+        SyncStoreRelaxed(&resync[idx].Tap, tap);    /* on to the new tap from the end stop */
+    }else if((Initial == state) || (Stop == state)){
+        if(tap != cur){
+            if(RESYNC_DUE(resync[idx].Pulses)){
+                resyncBegin(idx, cur, tap, resyncPulses(cur));
+            }else{
+                beginMove(idx, cur, tap);
+            }
+        }else{
+            /* already there: no move, the Stop reports the request */
+            POT(idx, MoveDownFlag) = False;
+            POT(idx, MoveUpFlag) = False;
+            if(Initial == state){
+                SyncStore(&stopTick[idx], tickCount);
+                POT(idx, STATE) = Stop;
+                LOG_EVENT(idx, Stop);
+            }/*ELSE: Do nothing*/
+        }
+    }else{
+        if(((tap > cur) && (False == up)) || ((tap < cur) && (True == up))){
+            beginMove(idx, cur, tap);           /* reversed: setup sequence again for the new U/D */
+        }else{
+            /* same direction: the move ends at the new tap */
+            if(True == up){
+                SyncStore(&POT(idx, stopEdges), (u8)(tap - start));
+            }else{
+                SyncStore(&POT(idx, stopEdges), (u8)(start - tap));
+            }
+        }
+    }
+}
+
+/********************************************************************
+* FUNCTION   : static void beginMove(u8 idx, u8 cur, u8 tap)
+* PURPOSE    : Plan the INC edges from the current tap, set the inputs up
+* PARAMETERS : u8 idx               //channel index
+*              u8 cur               //tap the wiper is at
+*              u8 tap               //target tap, not cur
+* RETURN     : void
+* NOTE       : called from the ISR; the U/D and INC writes belong to the
+*              request and are not taken off the pin budget
+**********************************************************************/
+static void beginMove(u8 idx, u8 cur, u8 tap){
+    bool up = (bool)(tap > cur);
+
+    SyncStoreRelaxed(&moveSeq[idx], moveSeq[idx] + 1U);
+    SyncFenceRelease();                     /* odd sequence is visible before the move changes */
+    POT(idx, startTap) = cur;
+    SyncStoreRelaxed(&POT(idx, edges), 0U);
+    if(True == up){
+        SyncStoreRelaxed(&POT(idx, stopEdges), (u8)(tap - cur));
+    }else{
+        SyncStoreRelaxed(&POT(idx, stopEdges), (u8)(cur - tap));
+    }
+    if(up != POT(idx, updwn_ctrl)){
+        POT(idx, updwn_ctrl) = up;
+        holdTick[idx] = tickCount;                  /* U/D settles before the next INC fall */
+        DUALPOT_STAT(isrReversals[idx]++);
+    }/*ELSE: Do nothing*/
+    if(False == POT(idx, inc_ctrl)){
+        holdTick[idx] = tickCount;                  /* INC high a tick before it falls */
+    }/*ELSE: Do nothing*/
+    SyncStore(&moveSeq[idx], moveSeq[idx] + 1U);
+    statusDirty = True;
+
+    POT(idx, MoveUpFlag) = up;
+    POT(idx, MoveDownFlag) = (bool)!up;
+    POT(idx, inc_ctrl) = True;                      /* setting increment control signal to high */
+    PinWrite(pinUD[idx], POT(idx, updwn_ctrl));
+    PinWrite(pinINC[idx], POT(idx, inc_ctrl));
+    if(Setup1 != POT(idx, STATE)){
+        POT(idx, STATE) = Setup1;                   /* chip select drop and U/D next */
+        LOG_EVENT(idx, Setup1);
+    }/*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : static void resyncBegin(u8 idx, u8 cur, u8 tap, u8 pulses)
+* PURPOSE    : Drive the wiper into the end stop nearer cur, then on to tap
+* PARAMETERS : u8 idx               //channel index
+*              u8 cur               //tap the wiper is believed at
+*              u8 tap               //target behind the end stop
+*              u8 pulses            //pulses into the end stop, 1..FULL_TAP
+* RETURN     : void
+* NOTE       : called from the ISR. The move is planned from a start
+*              pulses away from the end stop, so the edge count lands on
+*              it and the tap is exact from there on whatever the wiper
+*              really was at; until then curr_Tap runs from that start
+**********************************************************************/
+static void resyncBegin(u8 idx, u8 cur, u8 tap, u8 pulses){
+
+    if(MIN_TAP == RESYNC_END(cur)){
+        beginMove(idx, (u8)(MIN_TAP + pulses), (u8)MIN_TAP);
+    }else{
+        beginMove(idx, (u8)(FULL_TAP - pulses), (u8)FULL_TAP);
+    }
+    SyncStoreRelaxed(&resync[idx].Tap, tap);
+    SyncStoreRelaxed(&resync[idx].On, 1U);
+    DUALPOT_STAT(isrResyncs[idx]++);
+}
+
+/********************************************************************
+* FUNCTION   : static bool resyncEnd(u8 idx)
+* PURPOSE    : Go on from the end stop once a resync reached it
+* PARAMETERS : u8 idx               //channel index, planned edges issued
+* RETURN     : bool                 //True if a move on to the target started
+* NOTE       : called from the ISR
+**********************************************************************/
+static bool resyncEnd(u8 idx){
+    bool retVal = False;                    /* return value */
+    u8 end;                                 /* end stop the wiper is at */
+
+    if(0U != resync[idx].On){
+        end = (True == POT(idx, updwn_ctrl)) ? (u8)FULL_TAP : (u8)MIN_TAP;
+        SyncStoreRelaxed(&resync[idx].On, 0U);
+        SyncStoreRelaxed(&resync[idx].Pulses, 0U);
+        if(resync[idx].Tap != end){
+            beginMove(idx, end, resync[idx].Tap);
+            retVal = True;
+        }/*ELSE: Do nothing, the target is the end stop*/
+    }/*ELSE: Do nothing*/
+    return retVal;
+}
+
+/********************************************************************
+* FUNCTION   : static u8 resyncPulses(u8 cur)
+* PURPOSE    : Pulses of a resync due after DUALPOT_RESYNC_PULSES
+* PARAMETERS : u8 cur               //tap the wiper is believed at
+* RETURN     : u8                   //distance to the nearer end stop plus
+*                                   //DUALPOT_RESYNC_MARGIN, at most full scale
+**********************************************************************/
+static u8 resyncPulses(u8 cur){
+    u32 pulses;
+
+    if(MIN_TAP == RESYNC_END(cur)){
+        pulses = (u32)(cur - MIN_TAP) + (u32)DUALPOT_RESYNC_MARGIN;
+    }else{
+        pulses = (u32)(FULL_TAP - cur) + (u32)DUALPOT_RESYNC_MARGIN;
+    }
+    if(pulses > (u32)(FULL_TAP - MIN_TAP)){
+        pulses = (u32)(FULL_TAP - MIN_TAP);
+    }
+    return (u8)pulses;
+}
+
+/********************************************************************
+* FUNCTION   : static void timerStart(void)
+* PURPOSE    : Start the timer unless it is running
+* PARAMETERS : void
+* RETURN     : void
+* NOTE       : the first start after Init configures the timer; nothing
+*              masks an interrupt, the timer has not run before
+**********************************************************************/
+static void timerStart(void){
+
+    if(False == timerUp){
+        PeriodicModuleInit();       /* Initialize periodic module, stopped and interrupt disabled */
+        if(TIMER_FREQ <= PeriodicFreqHzMax){    /* check if required rolling frequency is in range */
+            /* Setting rolling frequency and assign interrupt handler*/
+            PeriodicConfig(TIMER_FREQ, ISR_Timer25us_Handler);
+        }
+        PeriodicIruptEnable();      /* the timer's own interrupt, it has never run */
+        timerUp = True;
+    }/*ELSE: Do nothing*/
+
+    if(False == timerRun){
+        publishStatus();                                    /* the request shows before the ISR takes over */
+        incr_ctrl = True;                                   /* first toggle is a falling edge */
+        updwn50usFlag = False;                              /* first tick drops chip select */
+#ifdef PERIODIC_ROLLOVERS
+        rollSeen = PeriodicRollovers();                     /* a stopped timer loses no rollovers */
+        rollOverrun = rollSeen - STRIDE_BURST;              /* no burst across a stop */
+#endif
+        strideSkip = 0U;
+        PeriodicStart();
+        timerRun = True;
+    }/*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : static bool strideTake(void)
+* PURPOSE    : Decide whether this handler call steps the channels
+* PARAMETERS : void
+* RETURN     : bool                 //True to step, False to leave the pins
+* NOTE       : called from the ISR. Rollovers that passed without a call
+*              mean the call before overran its tick; if it stepped, its
+*              pin writes may be just before this call, which is skipped.
+*              An overrun that falls on a due step within STRIDE_BURST
+*              ticks of the one before doubles the ticks per step; they
+*              halve again after every STRIDE_CALM ticks without one.
+*              Without PERIODIC_ROLLOVERS every call steps
+**********************************************************************/
+static bool strideTake(void){
+#ifdef PERIODIC_ROLLOVERS
+    u32 lost = PeriodicRollovers() - rollSeen;  /* rollovers since the last call */
+    bool late = False;                          /* right after the pin writes of an overrun */
+
+    rollSeen += lost;
+    if(1U < lost){
+        DUALPOT_STAT(isrOverruns++);
+        lost--;                                 /* ticks that passed without a call */
+        if(lost < strideSkip){
+            strideSkip -= lost;                 /* fell on skipped ticks, the step stays due */
+        }else{
+            strideSkip = 0U;
+            late = strideStepped;
+            if((rollSeen - rollOverrun) < STRIDE_BURST){
+                stride *= 2U;                   /* overruns keep coming */
+                if(STRIDE_MAX < stride){
+                    stride = STRIDE_MAX;
+                }/*ELSE: Do nothing*/
+            }/*ELSE: Do nothing, a lone overrun costs this call only*/
+        }
+        rollOverrun = rollSeen;
+        strideCalm = 0U;
+    }else if(1U < stride){
+        strideCalm += lost;
+        if(STRIDE_CALM <= strideCalm){
+            stride /= 2U;
+            strideCalm = 0U;
+        }/*ELSE: Do nothing*/
+    }/*ELSE: Do nothing*/
+
+    if(True == late){
+        strideStepped = False;
+        return False;                           /* the step is due at the next call */
+    }/*ELSE: Do nothing*/
+    if(0U != strideSkip){
+        strideSkip--;
+        strideStepped = False;
+        return False;
+    }/*ELSE: Do nothing*/
+
+    strideSkip = stride - 1U;
+    strideStepped = True;
+    return True;
+#else
+    return True;
+#endif
+}
+
+/********************************************************************
+* FUNCTION   : static void publishStatus(void)
+* PURPOSE    : Publish the channel states for DualPotDrv_GetStatus
+* PARAMETERS : void
+* RETURN     : void
+* NOTE       : single writer: the ISR while the timer runs, the bottom half
+*              while it is stopped (statusUpdate). The tap comes from the
+*              edges the ISR issued, so the snapshot follows the wiper
+*              without DualPotDrv_Main or DualPotDrv_Deferred calls.
+*              The handoff goes through timerRun and isrBusy, see idleCheck
+**********************************************************************/
+static void publishStatus(void){
+    DualPotStatusT *status = DualPotStatus_WriteBegin();
+    u8 idx;
+
+    status->Tick = tickCount;
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if(True == POT(idx, updwn_ctrl)){
+            status->Ch[idx].CurrTap = (u8)(POT(idx, startTap) + POT(idx, edges));
+        }else{
+            status->Ch[idx].CurrTap = (u8)(POT(idx, startTap) - POT(idx, edges));
+        }
+        status->Ch[idx].TargetTap = POT(idx, tapVal);
+        status->Ch[idx].State = (u8)POT(idx, STATE);
+        if((True == cmdPending(idx)) && ((Initial == POT(idx, STATE)) || (Stop == POT(idx, STATE)))){
+            status->Ch[idx].State = (u8)Setup1;     /* the ISR starts the move at its next tick */
+        }/*ELSE: Do nothing*/
+        status->Ch[idx].Late = (u8)deferCh[idx].late;
+    }
+    DualPotStatus_WriteEnd();
+}
+
+/********************************************************************
+* FUNCTION   : static void statusUpdate(void)
+* PURPOSE    : Publish the status from the bottom half while the timer is stopped
+* PARAMETERS : void
+* RETURN     : void
+* NOTE       : while it runs the ISR publishes after the ticks that change
+*              the status; a change made here is handed to it in statusAsk
+**********************************************************************/
+static void statusUpdate(void){
+
+    if(False == timerRun){
+        publishStatus();
+    }else if(True == statusStale){
+        SyncStore(&statusAsk, statusAsk + 1U);  /* published at the next tick */
+    }/*ELSE: Do nothing*/
+    statusStale = False;
+}
+
+/********************************************************************
+* FUNCTION   : static void drainIsr(void)
+* PURPOSE    : Fold the ISR progress into the bottom half state
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+static void drainIsr(void){
+    u8 idx;
+#if DUALPOT_STATS
+    u32 tick = SyncLoad(&tickCount);
+    u32 count;
+    u32 head = SyncLoad(&eventHead);
+    const isrEventT *event;
+
+    /* events first, so StateTicks never run ahead of an unread state change */
+    while(eventTail != head){
+        event = &eventBuf[eventTail & (EVENT_QUAN - 1U)];
+        stateTicksAdd(event->Idx, event->Tick, event->State);
+        SyncStore(&eventTail, eventTail + 1U);
+    }
+
+    DualPotStats->IsrCount += tick - tickSeen;
+    tickSeen = tick;
+    count = SyncLoad(&isrOverruns);
+    DualPotStats->IsrOverruns += count - overrunsSeen;
+    overrunsSeen = count;
+    count = SyncLoad(&isrSkipped);
+    DualPotStats->IsrSkipped += count - skippedSeen;
+    skippedSeen = count;
+#endif
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        syncTap(idx);
+        DUALPOT_STAT(stateTicksAdd(idx, tick + 1U, deferCh[idx].lastState));  /* ticks up to now */
+
+        /* still moving past the deadline: a miss, whenever the move ends */
+        if((True == dueSet[idx]) && (False == deferCh[idx].late) &&
+           (Initial != POT(idx, STATE)) && (Stop != POT(idx, STATE)) &&
+           TICK_AFTER(SyncLoad(&tickCount), dueTick[idx])){
+            deferCh[idx].late = True;
+            statusStale = True;
+            DUALPOT_STAT(DualPotStats->Ch[idx].DeadlineMissed++);
+        }
+    }
+}
+
+/********************************************************************
+* FUNCTION   : static void syncTap(u8 idx)
+* PURPOSE    : Derive the wiper tap from the INC edges issued so far
+* PARAMETERS : u8 idx               //channel index
+* RETURN     : void
+**********************************************************************/
+static void syncTap(u8 idx){
+    u32 seqBegin;
+    u32 seqEnd;
+    u8 start;
+    u8 edges;
+    bool up;
+#if DUALPOT_STATS
+    u32 pulses = SyncLoad(&isrPulses[idx]);
+    u32 reversals = SyncLoad(&isrReversals[idx]);
+    u32 resyncs = SyncLoad(&isrResyncs[idx]);
+
+    DualPotStats->Ch[idx].IncPulses += pulses - deferCh[idx].pulsesSeen;
+    deferCh[idx].pulsesSeen = pulses;
+    DualPotStats->Ch[idx].Reversals += reversals - deferCh[idx].reversalsSeen;
+    deferCh[idx].reversalsSeen = reversals;
+    DualPotStats->Ch[idx].Resyncs += resyncs - deferCh[idx].resyncsSeen;
+    deferCh[idx].resyncsSeen = resyncs;
+#endif
+
+    /* a trajectory may replan the move while it is read */
+    do{
+        seqBegin = SyncLoad(&moveSeq[idx]);
+        start = SyncLoadRelaxed(&POT(idx, startTap));
+        edges = SyncLoadRelaxed(&POT(idx, edges));
+        up = POT(idx, updwn_ctrl);
+        SyncFenceAcquire();                 /* reads complete before the sequence is re-read */
+        seqEnd = SyncLoadRelaxed(&moveSeq[idx]);
+    }while((0U != (seqBegin & 1U)) || (seqBegin != seqEnd));
+
+    if(True == up){
+        POT(idx, curr_Tap) = (u8)(start + edges);
+    }else{
+        POT(idx, curr_Tap) = (u8)(start - edges);
+    }
+}
+
+/********************************************************************
+* FUNCTION   : static void completeMoves(void)
+* PURPOSE    : Report every move that reached Stop since the last call
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+static void completeMoves(void){
+    u8 idx;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if((Stop == POT(idx, STATE)) && (False == deferCh[idx].doneSent) && (0U == traj[idx].On) &&
+           (False == cmdPending(idx))){
+            syncTap(idx);                       /* final edge count */
+            POT(idx, MoveDownFlag) = False;     /* reset move up or move down flag */
+            POT(idx, MoveUpFlag) = False;
+            deferCh[idx].doneSent = True;
+
+            /* deadline met or missed, the next move is scheduled without it */
+            if(True == dueSet[idx]){
+                if(False == deferCh[idx].late){
+                    if(TICK_AFTER(SyncLoad(&stopTick[idx]), dueTick[idx])){
+                        deferCh[idx].late = True;
+                        statusStale = True;
+                        DUALPOT_STAT(DualPotStats->Ch[idx].DeadlineMissed++);
+                    }else{
+                        DUALPOT_STAT(DualPotStats->Ch[idx].DeadlineMet++);
+                    }
+                }/*ELSE: Do nothing, counted while moving*/
+                dueSet[idx] = False;
+                schedUpdate();
+            }/*ELSE: Do nothing*/
+
+            DualPotDone_Notify(CH_NUM(idx), POT(idx, curr_Tap));
+        }
+    }
+}
+
+/********************************************************************
+* FUNCTION   : static bool idleCheck(void)
+* PURPOSE    : Stop the timer once no channel is moving
+* PARAMETERS : void
+* RETURN     : bool                 //True if a channel stopped and none moves
+* NOTE       : a stop completeMoves has not seen yet, the ISR ended the move
+*              after it ran, counts as moving: its tap is not synced yet;
+*              so does a command the ISR has not taken yet.
+*              The status passes back to the bottom half without masking
+*              the interrupt: timerRun is cleared before isrBusy is read,
+*              and the ISR makes isrBusy odd before it reads timerRun, so
+*              either the ISR sees the timer stopped or this waits for its
+*              publish to end. On one core the ISR has always returned
+*              and the wait never spins
+**********************************************************************/
+static bool idleCheck(void){
+    bool anyStop = False;                   /* at least one channel reached its target */
+    bool anyBusy = False;                   /* at least one channel is still moving */
+    u8 idx;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if((0U != traj[idx].On) || (True == cmdPending(idx))){
+            anyBusy = True;                     /* the timer plays the trajectory or has a request to take */
+        }else{
+            if(Stop == POT(idx, STATE)){
+                if(True == deferCh[idx].doneSent){
+                    anyStop = True;
+                }else{
+                    anyBusy = True;
+                }
+            }else{
+                if(Initial != POT(idx, STATE)){
+                    anyBusy = True;
+                }/*ELSE: Do nothing*/
+            }
+        }
+    }
+
+    /* If no channel is running, stop the timer */
+    if((True == anyStop) && (False == anyBusy)){
+        SyncStoreRelaxed(&timerRun, False);     /* the ISR stops publishing the status */
+        SyncFenceFull();                        /* cleared before isrBusy is read */
+        PeriodicStop();                         /* timer stop */
+        while(0U != (SyncLoad(&isrBusy) & 1U)){
+            /* a handler call on another core is still publishing */
+        }
+    }
+    return (bool)((True == anyStop) && (False == anyBusy));
+}
+
+/********************************************************************
+* FUNCTION   : static void stateSet(u8 idx, Sig_states state)
+* PURPOSE    : Change the signal state outside the ISR
+* PARAMETERS : u8 idx               //channel index
+*              Sig_states state     //new signal state
+* RETURN     : void
+**********************************************************************/
+static void stateSet(u8 idx, Sig_states state){
+
+    /* counts from the next tick on */
+    DUALPOT_STAT(stateTicksAdd(idx, SyncLoad(&tickCount) + 1U, (u8)state));
+    POT(idx, STATE) = state;
+    statusStale = True;
+}
+
+/********************************************************************
+* FUNCTION   : static void deadlineSet(u8 idx, u32 deadline)
+* PURPOSE    : Take the deadline of a new request and reorder the channels
+* PARAMETERS : u8 idx               //channel index
+*              u32 deadline         //ticks from now the move is due in, 0 for none
+* RETURN     : void
+**********************************************************************/
+static void deadlineSet(u8 idx, u32 deadline){
+
+    if((True == dueSet[idx]) || (0U != deadline)){
+        dueSet[idx] = (bool)(0U != deadline);
+        dueTick[idx] = SyncLoad(&tickCount) + deadline;
+        schedUpdate();
+    }/*ELSE: Do nothing, the order stays*/
+    deferCh[idx].late = False;
+    statusStale = True;
+}
+
+/********************************************************************
+* FUNCTION   : static void schedUpdate(void)
+* PURPOSE    : Publish the channel order for the deadlines in dueSet/dueTick
+* PARAMETERS : void
+* RETURN     : void
+* NOTE       : bottom half only; the ISR picks the new order up on its
+*              next tick and never sees a half written one
+**********************************************************************/
+static void schedUpdate(void){
+    u8 sel = (u8)(1U - schedSel);
+
+    schedBuild(schedOrder[sel], dueSet, dueTick);
+    SyncStore(&schedSel, sel);
+}
+
+/********************************************************************
+* FUNCTION   : static void schedBuild(u8 *order, const bool *set, const u32 *due)
+* PURPOSE    : Order the channels earliest deadline first
+* PARAMETERS : u8 *order            //channel indices, in the order to serve
+*              const bool *set      //channel has a deadline
+*              const u32 *due       //deadline tick of the channel
+* RETURN     : void
+* NOTE       : channels without a deadline follow in channel order,
+*              equal deadlines keep channel order
+**********************************************************************/
+static void schedBuild(u8 *order, const bool *set, const u32 *due){
+    u8 quan = 0U;                           /* channels placed */
+    u8 pos;
+    u8 idx;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if(True == set[idx]){
+            for(pos = quan; (0U < pos) && TICK_AFTER(due[order[pos - 1U]], due[idx]); pos--){
+                order[pos] = order[pos - 1U];
+            }
+            order[pos] = idx;
+            quan++;
+        }
+    }
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if(False == set[idx]){
+            order[quan] = idx;
+            quan++;
+        }
+    }
+}
+
+#if DUALPOT_STATS
+/********************************************************************
+* FUNCTION   : static void logEvent(u8 idx, Sig_states state)
+* PURPOSE    : Queue a state change made by the ISR for the bottom half
+* PARAMETERS : u8 idx               //channel index
+*              Sig_states state     //state entered this tick
+* RETURN     : void
+**********************************************************************/
+static void logEvent(u8 idx, Sig_states state){
+    isrEventT *event;
+
+    if((eventHead - SyncLoad(&eventTail)) < EVENT_QUAN){
+        event = &eventBuf[eventHead & (EVENT_QUAN - 1U)];
+        event->Tick = tickCount;
+        event->Idx = idx;
+        event->State = (u8)state;
+        SyncStore(&eventHead, eventHead + 1U);
+    }else{
+        DualPotStats->EventsLost++;
+    }
+}
+
+/********************************************************************
+* FUNCTION   : static void stateTicksAdd(u8 idx, u32 tick, u8 state)
+* PURPOSE    : Close the StateTicks interval of the previous state
+* PARAMETERS : u8 idx               //channel index
+*              u32 tick             //first tick counted for state
+*              u8 state             //state entered
+* RETURN     : void
+**********************************************************************/
+static void stateTicksAdd(u8 idx, u32 tick, u8 state){
+
+    /* ticks are numbered modulo 2^32, later ticks lie in the lower half */
+    if((tick - deferCh[idx].lastTick) < 0x80000000UL){
+        DualPotStats->Ch[idx].StateTicks[deferCh[idx].lastState] += tick - deferCh[idx].lastTick;
+        deferCh[idx].lastTick = tick;
+    }
+    deferCh[idx].lastState = state;
+}
+#endif
+
+/********************************************************************
+* FUNCTION   : void ISR_Timer25us_Handler(void)
+* PURPOSE    : ISR
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+void ISR_Timer25us_Handler(void){
+
+    bool active = False;            /* at least one channel is requested */
+    bool toggle = False;            /* at least one channel is in Setup2/Running signal state */
+    bool udTick;                    /* tick writing U/D, else dropping chip select */
+    u32 budget = PIN_BUDGET;        /* pin writes left this tick */
+    u32 writes;                     /* pin writes of a trajectory point */
+    const u8 *order;                /* channels, earliest deadline first */
+    u32 ask;                        /* statusAsk of this tick */
+    u8 idx;
+    u8 k;
+#if DUALPOT_STATS_CYCLES || DUALPOT_PROFILE
+    u64 cycleStart = CycleNow();    /* ISR entry, for IsrMaxCycles and the profile */
+    u32 cycles;
+#endif
+#if DUALPOT_PROFILE
+    u8 branches = 0U;               /* DUALPOT_BRANCH_x that ran */
+    u8 moving = 0U;                 /* channels in Setup1..Running */
+#endif
+
+    SyncStore(&tickCount, tickCount + 1U);
+
+    if(False == strideTake()){
+        DUALPOT_STAT(isrSkipped++);
+        PeriodicIruptFlagClear();                   /* no step this tick */
+        return;
+    }/*ELSE: Do nothing*/
+
+    /* requests published since the last tick */
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        cmdTake(idx);
+    }
+
+    /* Check if any channel is active */
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if(CH_NUM(idx) == POT(idx, channel)){
+            active = True;
+        }
+#if DUALPOT_PROFILE
+        if((Initial != POT(idx, STATE)) && (Stop != POT(idx, STATE))){
+            moving++;
+        }
+#endif
+    }
+
+    if(True == active){
+
+        /* setpoints of the trajectories falling due this tick, their U/D writes come off the budget */
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            if(0U != SyncLoad(&traj[idx].On)){
+                writes = trajTick(idx);
+                if(budget > writes){
+                    budget -= writes;
+                }else{
+                    budget = 0U;
+                }
+            }
+        }
+
+        /* If ISR is hit for the first time UpDown control signal will not be set as it needs 50us time*/
+        udTick = updwn50usFlag;
+        updwn50usFlag = (bool)!updwn50usFlag;           /* U/D every other tick, chip select on the ones between */
+
+        /* Inverting the Increment control signal every 25us if channels are in Setup2/Running signal state
+         * or enter Setup2 this tick */
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            if((Setup2 == POT(idx, STATE)) || (Running == POT(idx, STATE)) ||
+               ((True == udTick) && (Setup1 == POT(idx, STATE)) && (False == POT(idx, cs)) &&
+                (tickCount != holdTick[idx]))){
+                toggle = True;
+            }
+        }
+
+        if(True == toggle){
+            incr_ctrl = (bool) !incr_ctrl;
+            DUALPOT_PROF(branches |= DUALPOT_BRANCH_INC_TOGGLE);
+        }
+
+        /* serve the channels earliest deadline first, as long as the pin budget lasts */
+        order = schedOrder[SyncLoad(&schedSel)];
+        for(k = 0U; k < DUALPOT_CH_QUAN; k++){
+            idx = order[k];
+
+            if((CH_NUM(idx) == POT(idx, channel)) && (Setup1 == POT(idx, STATE)) && (0U < budget)){
+                if(True == udTick){
+
+                    /* Check if the chip select of the channel is already low and
+                     * neither U/D changed nor INC rose in this tick */
+                    if((False == POT(idx, cs)) && (tickCount != holdTick[idx])){
+
+                        /* Up/Down control level planned by beginMove */
+                        PinWrite(pinUD[idx], POT(idx, updwn_ctrl));
+                        POT(idx, STATE) = Setup2;           /* change signal state to Setup2 */
+                        LOG_EVENT(idx, Setup2);
+                        statusDirty = True;
+                        DUALPOT_PROF(branches |= DUALPOT_BRANCH_UD_WRITE);
+                        budget--;
+                    }/*ELSE: Do nothing*/
+                }else{
+
+                    /* setting chip select of the channel to low */
+                    if(True == POT(idx, cs)){
+                        POT(idx, cs) = False;
+                        PinWrite(pinCS[idx], POT(idx, cs));
+                        DUALPOT_PROF(branches |= DUALPOT_BRANCH_CS_DROP);
+                        budget--;
+                    }/*ELSE: Do nothing, still low from the reversed move*/
+                }
+            }
+
+            if(True == toggle){
+                budget = setWiper(idx, budget);     /* write increment control, count taps, complete the move */
+            }
+        }
+    }
+
+    PinFlush();                                     /* issue the pin writes due this tick */
+
+    /* taps and states after this tick, if it or the bottom half changed them */
+    ask = SyncLoad(&statusAsk);
+    if((True == statusDirty) || (ask != statusSeen)){
+        SyncStoreRelaxed(&isrBusy, isrBusy + 1U);   /* odd: may publish, see idleCheck */
+        SyncFenceFull();                            /* odd before timerRun is read */
+        if(True == SyncLoadRelaxed(&timerRun)){
+            publishStatus();
+            statusDirty = False;
+            statusSeen = ask;
+        }/*ELSE: Do nothing, stopped meanwhile: the bottom half publishes*/
+        SyncStore(&isrBusy, isrBusy + 1U);
+    }/*ELSE: Do nothing, the snapshot is current*/
+    PeriodicIruptFlagClear();                       /* Clear interrupt flag */
+
+#if DUALPOT_STATS_CYCLES || DUALPOT_PROFILE
+    cycles = (u32)(CycleNow() - cycleStart);
+#endif
+#if DUALPOT_STATS_CYCLES
+    if(cycles > DualPotStats->IsrMaxCycles){
+        DualPotStats->IsrMaxCycles = cycles;
+    }
+#endif
+    DUALPOT_PROF(DualPotProfile_Record(branches, moving, cycles));
+}
@@ -0,0 +1,267 @@
+/*H**********************************************************************
+* FILENAME : DualPot_PinCheck.c
+* DESCRIPTION : Pin sequence check of the MAX5389 state machine
+* NOTES : Sends random request sequences to DualPotDrv_Main on the
+*         simulated timer of a register level HAL and follows the port
+*         with a MAX5389 model after every handler call and every
+*         DualPotDrv_Main call. Requests land on idle, stopped and
+*         moving channels, often reversing one. Checks per channel:
+*         - INC falls only with chip select low since an earlier sample
+*           and U/D unchanged in that sample;
+*         - chip select rises only with INC high;
+*         - once both channels are polled, the request completes within
+*           PINCHECK_SETTLE ticks with the model wiper at the requested
+*           tap and the chip released.
+*         With the out-of-line pin backend (REGS, REGFILE) every pad
+*         write is seen as well, in order, and checked for INC falling
+*         with chip select high and chip select rising with INC low
+*         within a tick; -d runs the pin shadow register in deferred
+*         mode, where a tick's writes go out together from PinFlush.
+*         Each sequence starts from a cold DualPotDrv_Init with the
+*         model wiper at MID_TAP, as after a power cycle. A failing
+*         sequence prints its seed; -s with -n 1 replays it.
+*         usage: DualPot_PinCheck [-n sequences] [-s seed] [-d]
+*         Exits with 1 if a sequence failed.
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "DualPot_Drv.h"
+#include "HalRegs.h"
+#include "PeriodicSim.h"
+
+#if (DUALPOT_DEVICE != DUALPOT_DEVICE_MAX5389)
+#error "DualPot_PinCheck checks the MAX5389 state machine"
+#endif
+
+#define PINCHECK_SEQUENCES 2000UL       /* default sequences */
+#define PINCHECK_REQUESTS  24U          /* requests per sequence */
+#define PINCHECK_SETTLE    (8U * (FULL_TAP + 1U))   /* four end to end moves */
+
+static u32 seed = 1U;
+static u32 pinsSeen;                    /* port at the last sample */
+static u32 padSeen;                     /* port after the last pad write */
+static u8 wiper[DUALPOT_CH_QUAN];       /* model wiper per channel */
+static u32 tick;                        /* ticks into the sequence */
+static const char *failure;             /* first check that failed */
+static u8 failCh;
+
+static u32 randomNext(void){
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static void fail(const char *What, u8 Idx){
+    if(0 == failure){
+        failure = What;
+        failCh = (u8)(chA + Idx);
+    }/*ELSE: Do nothing*/
+}
+
+/* follow the port since the last sample */
+static void sample(void){
+    u32 pins = HAL_REGS->PinOut;
+    u32 was = pinsSeen;
+    u32 cs;
+    u32 ud;
+    u32 inc;
+    u8 idx;
+
+    pinsSeen = pins;
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        cs = 1UL << (PinCSA + idx);
+        ud = 1UL << (PinUDA + idx);
+        inc = 1UL << (PinINCA + idx);
+
+        if((0UL != (was & inc)) && (0UL == (pins & inc))){
+            if((0UL != (was & cs)) || (0UL != (pins & cs))){
+                fail("INC fell without chip select low since an earlier sample", idx);
+            }/*ELSE: Do nothing*/
+            if(0UL != ((was ^ pins) & ud)){
+                fail("U/D changed in the sample INC fell", idx);
+            }/*ELSE: Do nothing*/
+            if(0UL != (pins & ud)){
+                if(FULL_TAP != wiper[idx]){
+                    wiper[idx]++;
+                }/*ELSE: Do nothing*/
+            }else{
+                if(MIN_TAP != wiper[idx]){
+                    wiper[idx]--;
+                }/*ELSE: Do nothing*/
+            }
+        }/*ELSE: Do nothing*/
+
+        if((0UL == (was & cs)) && (0UL != (pins & cs)) && (0UL == (pins & inc))){
+            fail("chip select rose with INC low", idx);
+        }/*ELSE: Do nothing*/
+    }
+}
+
+#ifndef HAL_INLINE
+/* follow the port write by write: the order rules within a tick */
+static void padWritten(void){
+    u32 pads = HAL_REGS->PinOut;
+    u32 was = padSeen;
+    u32 cs;
+    u32 inc;
+    u8 idx;
+
+    padSeen = pads;
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        cs = 1UL << (PinCSA + idx);
+        inc = 1UL << (PinINCA + idx);
+
+        if((0UL != (was & inc)) && (0UL == (pads & inc)) && (0UL != (pads & cs))){
+            fail("INC fell with chip select high", idx);
+        }/*ELSE: Do nothing*/
+        if((0UL == (was & cs)) && (0UL != (pads & cs)) && (0UL == (pads & inc))){
+            fail("chip select rose with INC low within a tick", idx);
+        }/*ELSE: Do nothing*/
+    }
+}
+#endif
+
+static void run(u32 Ticks){
+    u32 i;
+
+    for(i = 0U; i < Ticks; i++){
+        PeriodicSimRun(1U);
+        tick++;
+        sample();
+    }
+}
+
+static bool request(u8 Channel, f32 Resistance){
+    bool done = DualPotDrv_Main(Channel, Resistance);
+
+    sample();
+    return done;
+}
+
+/* one sequence from a cold start; True if every check passed */
+static bool sequence(void){
+    f32 target[DUALPOT_CH_QUAN];
+    bool asked[DUALPOT_CH_QUAN];
+    u8 want;
+    u32 r;
+    u32 gap;
+    u32 settled;
+    u8 idx;
+    u8 i;
+    bool done;
+
+    DualPotDrv_Init();
+    pinsSeen = HAL_REGS->PinOut;
+    padSeen = pinsSeen;
+    tick = 0U;
+    failure = 0;
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        wiper[idx] = MID_TAP;
+        asked[idx] = False;
+    }
+
+    for(i = 0U; (i < PINCHECK_REQUESTS) && (0 == failure); i++){
+        idx = (u8)(randomNext() % DUALPOT_CH_QUAN);
+        target[idx] = (f32)(randomNext() % 10001U);
+        asked[idx] = True;
+        (void)request((u8)(chA + idx), target[idx]);
+
+        /* back to back, within the setup, mid move or after the stop */
+        r = randomNext() % 8U;
+        gap = (r < 2U) ? 0U : ((r < 5U) ? (randomNext() % 8U) : (randomNext() % 600U));
+        run(gap);
+    }
+
+    /* poll every requested channel until all of them stopped */
+    settled = 0U;
+    do{
+        done = True;
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            if(True == asked[idx]){
+                if(False == request((u8)(chA + idx), target[idx])){
+                    done = False;
+                }/*ELSE: Do nothing*/
+            }/*ELSE: Do nothing*/
+        }
+        if(False == done){
+            run(1U);
+            settled++;
+        }/*ELSE: Do nothing*/
+    }while((False == done) && (settled <= PINCHECK_SETTLE) && (0 == failure));
+
+    if((False == done) && (0 == failure)){
+        fail("request not complete within PINCHECK_SETTLE ticks", 0U);
+    }/*ELSE: Do nothing*/
+    for(idx = 0U; (idx < DUALPOT_CH_QUAN) && (0 == failure); idx++){
+        want = MID_TAP;
+        if(True == asked[idx]){
+            (void)DualPotDrv_GetTapBatch(&target[idx], &want, 1U);
+        }/*ELSE: Do nothing*/
+        if(want != wiper[idx]){
+            fail("stopped with the model wiper off the requested tap", idx);
+        }/*ELSE: Do nothing*/
+        if(0UL == (pinsSeen & (1UL << (PinCSA + idx)))){
+            fail("stopped with the chip still selected", idx);
+        }/*ELSE: Do nothing*/
+    }
+
+    DualPotDrv_DeInit();
+    return (0 == failure) ? True : False;
+}
+
+int main(int argc, char *argv[]) {
+    u64 sequences = PINCHECK_SEQUENCES;
+    u64 s;
+    u64 ticks = 0U;
+    u32 start;
+    bool deferred = False;
+    int opt;
+
+    while(-1 != (opt = getopt(argc, argv, "n:s:d"))){
+        switch(opt){
+        case 'n':
+            sequences = strtoull(optarg, 0, 10);
+            break;
+        case 's':
+            seed = (u32)strtoul(optarg, 0, 10);
+            break;
+        case 'd':
+            deferred = True;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n sequences] [-s seed] [-d]\n", argv[0]);
+            return 2;
+        }
+    }
+#ifdef HAL_INLINE
+    if(True == deferred){
+        fprintf(stderr, "-d needs the pin shadow register, not in the INLINE HAL\n");
+        return 2;
+    }
+#else
+    if(True == deferred){
+        PinShadowModeSet(PinShadowDeferred);
+    }
+    PinSimWatch(padWritten);
+#endif
+    if(0U == seed){
+        seed = 1U;                      /* xorshift stays at 0 */
+    }
+
+    for(s = 0U; s < sequences; s++){
+        start = seed;
+        if(False == sequence()){
+            printf("sequence %llu (seed %u) failed at tick %u, ch%u: %s\n", (unsigned long long)s, start,
+                   tick, failCh, failure);
+            return 1;
+        }
+        ticks += tick;
+    }
+    printf("%llu sequences of %u requests, %llu ticks%s: pin sequences and taps check out\n",
+           (unsigned long long)sequences, PINCHECK_REQUESTS, (unsigned long long)ticks,
+           (True == deferred) ? ", deferred pin writes" : "");
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Profile.c
+* DESCRIPTION : ISR cycle profiler of the DualPot driver
+* PUBLIC FUNCTIONS :
+*           void DualPotDrv_GetProfile(DualPotProfileT *profile)
+*           void DualPotDrv_ClearProfile(void)
+*           void DualPotProfile_Record(u8 branches, u8 moving, u32 cycles)
+* NOTES : Built with DUALPOT_PROFILE 1 the ISR measures itself with
+*         CycleNow() (time stamp counter on x86 hosts, CYCLE_SOURCE on
+*         target) and files every run twice: by the combination of
+*         branches that ran and by the number of moving channels.
+*         Buckets are powers of two, so recording is a count of leading
+*         zeros and three increments per histogram.
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   ISR cycle histograms
+* 0.1.1   18Oct2026   agent   Thread local histograms
+*H***********************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include <string.h>
+#include "DualPot_Dev.h"
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+#if DUALPOT_PROFILE
+static SyncLocal DualPotProfileT profileBuf; /* written by the ISR only */
+
+/******************************************************************************
+ *	local functions
+ ******************************************************************************/
+static void histAdd(DualPotHistT *hist, u32 cycles);
+
+/********************************************************************
+* FUNCTION   : void DualPotProfile_Record(u8 branches, u8 moving, u32 cycles)
+* PURPOSE    : Add one ISR run to the histograms
+* PARAMETERS : u8 branches          //DUALPOT_BRANCH_x that ran
+*              u8 moving            //channels in Setup1..Running at entry
+*              u32 cycles           //duration of the run
+* RETURN     : void
+**********************************************************************/
+void DualPotProfile_Record(u8 branches, u8 moving, u32 cycles){
+
+    histAdd(&profileBuf.Branch[branches & (DUALPOT_BRANCH_QUAN - 1U)], cycles);
+    if(moving <= DUALPOT_CH_QUAN){
+        histAdd(&profileBuf.Moving[moving], cycles);
+    }/*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : static void histAdd(DualPotHistT *hist, u32 cycles)
+* PURPOSE    : Count one sample in a histogram
+* PARAMETERS : DualPotHistT *hist   //histogram to update
+*              u32 cycles           //sample
+* RETURN     : void
+**********************************************************************/
+static void histAdd(DualPotHistT *hist, u32 cycles){
+    u32 bucket = 0U;
+
+    if(cycles > 1U){
+        bucket = 31U - (u32)__builtin_clz(cycles);  /* floor(log2(cycles)) */
+        if(bucket >= DUALPOT_PROFILE_BUCKETS){
+            bucket = DUALPOT_PROFILE_BUCKETS - 1U;
+        }
+    }
+
+    hist->Count++;
+    hist->SumCycles += cycles;
+    hist->Bucket[bucket]++;
+    if(cycles > hist->MaxCycles){
+        hist->MaxCycles = cycles;
+    }
+}
+#endif
+
+/********************************************************************
+* FUNCTION   : void DualPotDrv_GetProfile(DualPotProfileT *profile)
+* PURPOSE    : Copy the ISR histograms
+* PARAMETERS : DualPotProfileT *profile //destination of the copy
+* RETURN     : void
+**********************************************************************/
+void DualPotDrv_GetProfile(DualPotProfileT *profile){
+
+    if(0 != profile){
+#if DUALPOT_PROFILE
+        *profile = *(volatile DualPotProfileT *)&profileBuf;
+#else
+        memset(profile, 0, sizeof(*profile));
+#endif
+    }
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotDrv_ClearProfile(void)
+* PURPOSE    : Reset the ISR histograms
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+void DualPotDrv_ClearProfile(void){
+#if DUALPOT_PROFILE
+    memset((void *)&profileBuf, 0, sizeof(profileBuf));
+#endif
+}
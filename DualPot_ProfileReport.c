@@ -0,0 +1,158 @@
+/*H**********************************************************************
+* FILENAME : DualPot_ProfileReport.c
+* DESCRIPTION : ISR cycle profile report of the DualPot driver
+* NOTES : Drives random moves through the simulated timer, first on one
+*         channel and then on both, and prints the ISR histograms
+*         collected by a DUALPOT_PROFILE build: per branch combination
+*         and per number of moving channels. On the host the maximum
+*         includes preemption by the OS, so the 25us tick is checked
+*         against the bucket holding the 99.99th percentile instead.
+*         Run with the profile_report target.
+*         usage: DualPot_ProfileReport [moves per scenario]
+*         Exits with 1 if the percentile bound exceeds the tick.
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "DualPot_Drv.h"
+#include "PeriodicSim.h"
+#include "Cycle.h"
+
+#define REPORT_MOVES 2000UL             /* moves per scenario */
+#define CALIB_NS     50000000L          /* CycleNow() calibration interval */
+#define REPORT_PPM   100UL              /* runs allowed above the checked bound, per million */
+
+static u32 seed = 1U;
+
+static const char *const branchName[DUALPOT_BRANCH_QUAN] = {
+    "idle", "cs", "ud", "cs+ud", "inc", "cs+inc", "ud+inc", "cs+ud+inc"
+};
+
+static f32 randomResistance(void){
+    seed = seed * 1103515245U + 12345U;
+    return (f32)(seed >> 8) / (f32)(1UL << 24) * MAX_RESISTANCE;
+}
+
+static u64 nowNs(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+/* CycleNow() units per microsecond */
+static double cyclesPerUs(void){
+    u64 ns0 = nowNs();
+    u64 c0 = CycleNow();
+    u64 ns1;
+
+    do{
+        ns1 = nowNs();
+    }while((ns1 - ns0) < (u64)CALIB_NS);
+    return (double)(CycleNow() - c0) * 1000.0 / (double)(ns1 - ns0);
+}
+
+/* run Moves random moves of the given channels to completion */
+static void runMoves(u8 Channels, u32 Moves){
+    f32 target[DUALPOT_CH_QUAN];
+    bool done = False;
+    u32 move;
+    u8 idx;
+
+    for(move = 0U; move < Moves; move++){
+        for(idx = 0U; idx < Channels; idx++){
+            target[idx] = randomResistance();
+        }
+        done = False;
+        while(False == done){
+            for(idx = 0U; idx < Channels; idx++){
+                done = DualPotDrv_Main((u8)(chA + idx), target[idx]);
+            }
+            PeriodicSimRun(1U);
+        }
+    }
+}
+
+static void printHist(const char *Name, const DualPotHistT *Hist, double PerUs){
+    u8 bucket;
+
+    if(0U == Hist->Count){
+        return;
+    }
+    printf("  %-10s %9u %8.1f %8u %8.3f  ", Name, Hist->Count,
+           (double)Hist->SumCycles / (double)Hist->Count, Hist->MaxCycles,
+           (double)Hist->MaxCycles / PerUs);
+    for(bucket = 0U; bucket < DUALPOT_PROFILE_BUCKETS; bucket++){
+        if(0U != Hist->Bucket[bucket]){
+            printf(" <%lu:%u", 2UL << bucket, Hist->Bucket[bucket]);
+        }
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+    DualPotProfileT profile;
+    const double budgetUs = 1000000.0 / (double)TIMER_FREQ;
+    double perUs;
+    double boundUs;
+    u32 worst = 0U;
+    u32 moves = REPORT_MOVES;
+    u64 total = 0U;
+    u64 above;
+    u8 bucket;
+    u8 i;
+    char name[8];
+
+    if(argc > 1){
+        moves = (u32)strtoul(argv[1], 0, 10);
+    }
+
+    perUs = cyclesPerUs();
+    DualPotDrv_Init();
+    DualPotDrv_ClearProfile();
+    runMoves(1U, moves);
+    runMoves(DUALPOT_CH_QUAN, moves);
+    DualPotDrv_GetProfile(&profile);
+    DualPotDrv_DeInit();
+
+    printf("ISR profile, layout=%d, %.1f cycles/us, %u moves on 1 and %u channels\n",
+           DUALPOT_LAYOUT, perUs, moves, DUALPOT_CH_QUAN);
+    if(0U == profile.Moving[0].Count + profile.Moving[1].Count){
+        printf("no samples, build with -DDUALPOT_PROFILE=ON\n");
+        return 1;
+    }
+
+    printf("  %-10s %9s %8s %8s %8s   buckets (<cycles:count)\n", "branches", "count", "mean", "max", "max us");
+    for(i = 0U; i < DUALPOT_BRANCH_QUAN; i++){
+        printHist(branchName[i], &profile.Branch[i], perUs);
+        if(profile.Branch[i].MaxCycles > worst){
+            worst = profile.Branch[i].MaxCycles;
+        }
+    }
+    printf("  %-10s %9s %8s %8s %8s\n", "moving", "count", "mean", "max", "max us");
+    for(i = 0U; i <= DUALPOT_CH_QUAN; i++){
+        snprintf(name, sizeof(name), "%u", i);
+        printHist(name, &profile.Moving[i], perUs);
+        total += profile.Moving[i].Count;
+    }
+
+    /* smallest bucket bound with at most REPORT_PPM of all runs above it */
+    above = total;
+    for(bucket = 0U; bucket < DUALPOT_PROFILE_BUCKETS; bucket++){
+        for(i = 0U; i <= DUALPOT_CH_QUAN; i++){
+            above -= profile.Moving[i].Bucket[bucket];
+        }
+        if((above * 1000000ULL) <= (total * REPORT_PPM)){
+            break;
+        }
+    }
+    boundUs = (double)(2UL << bucket) / perUs;
+
+    printf("worst ISR %.3f us, 99.99%% of runs below %.3f us, tick %.1f us: %s\n",
+           (double)worst / perUs, boundUs, budgetUs,
+           (boundUs <= budgetUs) ? "within budget" : "OVER BUDGET");
+    return (boundUs <= budgetUs) ? 0 : 1;
+}
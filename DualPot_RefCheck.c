@@ -0,0 +1,737 @@
+/*H**********************************************************************
+* FILENAME : DualPot_RefCheck.c
+* DESCRIPTION : Differential check of the MAX5389 engine against a reference
+* NOTES : Plays random command streams (moves, moves with a deadline,
+*         resyncs, at random tick gaps) into the driver on the simulated
+*         timer and, after every tick, checks the port against a
+*         reference: a pin level MAX5389 and the behaviour the engine
+*         owes each command, kept here independently of
+*         ISR_Timer25us_Handler/setWiper. Per tick and channel:
+*         - INC falls only with chip select low since an earlier tick
+*           and U/D unchanged in that tick; chip select drops only for a
+*           move and rises only with INC high;
+*         - every wiper step heads for the tap last taken, or for the
+*           nearer end stop while a resync runs, which may not turn
+*           before the stop nor run beyond its planned pulses;
+*         - the driver's tap matches the modelled wiper, during a
+*           resync the count from its planned start; an idle channel
+*           reports Stop at its target. The status is read as the tick
+*           left it, before DualPotDrv_Deferred runs;
+*         - a move completes within two ticks per step plus setup,
+*           under DUALPOT_PIN_BUDGET counting only the ticks no other
+*           channel moves, and only the ISR calls that stepped;
+*         - the ISR call after an overrun leaves the port alone if the
+*           call before it stepped.
+*         With -o a share of the commands are handler overruns: the
+*         simulated timer lets 1..3 rollovers pass without a call.
+*         Each stream starts from a cold DualPotDrv_Init. The first
+*         stream that fails is shrunk, by dropping commands and shortening
+*         gaps as long as the same check still fails, and printed as a
+*         repro with a trace of its last ticks; -r replays a repro file.
+*         Edges are sampled once per tick, like the other pin models.
+*         usage: DualPot_RefCheck [-n streams] [-l commands] [-s seed] [-o percent]
+*                DualPot_RefCheck -r repro
+*         Exits with 1 if a stream failed.
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "DualPot_Drv.h"
+#include "HalRegs.h"
+#include "PeriodicSim.h"
+
+#if (DUALPOT_DEVICE != DUALPOT_DEVICE_MAX5389)
+#error "DualPot_RefCheck checks the MAX5389 engine"
+#endif
+#if !DUALPOT_STATS
+#error "DualPot_RefCheck tells the ISR calls that stepped by IsrSkipped"
+#endif
+
+#define CHECK_STREAMS   10000UL         /* default streams */
+#define CHECK_COMMANDS  48U             /* default commands per stream */
+#define CHECK_COMMANDS_MAX 4096U
+#define CHECK_SLACK     8U              /* ticks of setup and release a move may add */
+#define CHECK_TRACE     48U             /* ticks of trace printed with a repro */
+
+/* pulses since the last resync after which a move from rest resyncs */
+#if (0 == DUALPOT_RESYNC_PULSES)
+#define CHECK_RESYNC_DUE(pulses)    (False)
+#else
+#define CHECK_RESYNC_DUE(pulses)    ((pulses) >= (u32)DUALPOT_RESYNC_PULSES)
+#endif
+
+/* commands of a stream */
+enum {
+    CHECK_OP_MOVE = 0,                  /* DualPotDrv_MainTap */
+    CHECK_OP_RESYNC,                    /* DualPotDrv_Resync */
+    CHECK_OP_OVERRUN                    /* PeriodicSimOverrun, Tap rollovers */
+};
+
+static const char *const opName[] = {"move", "resync", "overrun"};
+
+/* checks, a shrunk stream has to fail the same one */
+enum {
+    CHECK_PASS = 0,
+    CHECK_INC_CS,                       /* INC fell with chip select high or just dropped */
+    CHECK_UD_SETUP,                     /* U/D changed in the tick INC fell */
+    CHECK_CS_RISE,                      /* chip select released with INC low */
+    CHECK_SELECT,                       /* chip select dropped with no move */
+    CHECK_DIRECTION,                    /* step away from the target */
+    CHECK_RESYNC,                       /* resync turned early or ran long */
+    CHECK_STOP,                         /* released away from the target */
+    CHECK_TAP,                          /* driver tap differs from the wiper */
+    CHECK_STATE,                        /* idle channel not reported as stopped */
+    CHECK_LATE,                         /* move took longer than its bound */
+    CHECK_DONE,                         /* DualPotDrv_MainTap reported done while moving */
+    CHECK_OVERRUN,                      /* port changed by the call after an overrun */
+    CHECK_QUAN
+};
+
+static const char *const checkName[CHECK_QUAN] = {
+    "pass", "inc-cs", "ud-setup", "cs-rise", "select", "direction", "resync", "stop", "tap",
+    "state", "late", "done", "overrun"
+};
+
+typedef struct {
+    u32 Gap;                            /* ticks before the command */
+    u8 Op;                              /* CHECK_OP_x */
+    u8 Channel;                         /* chA.. */
+    u8 Tap;                             /* target of a move, rollovers of an overrun */
+    u32 Deadline;                       /* ticks, 0 for none */
+} checkCmdT;
+
+typedef struct {
+    u8 Check;                           /* CHECK_x */
+    u8 Channel;
+    u32 Tick;                           /* ticks into the stream */
+    char Text[160];
+} checkFailT;
+
+/* reference of one channel */
+typedef struct {
+    u8 Wiper;                           /* modelled wiper */
+    u8 Target;                          /* tap of the command last taken */
+    u8 Requested;                       /* tap of the last move request, a resync goes on to it */
+    bool InFlight;                      /* a move was taken and the chip not released since */
+    bool Pending;                       /* a command published and not yet taken */
+    u8 PendTap;
+    bool PendFull;                      /* the pending command is a resync */
+    bool Resync;                        /* a resync runs */
+    u8 End;                             /* its end stop */
+    u32 ResyncPlanned;                  /* pulses it may issue towards the end stop */
+    u32 ResyncDone;
+    u32 Pulses;                         /* INC falling edges since the last resync */
+    u32 Bound;                          /* tick the move has to complete by */
+} refChT;
+
+static refChT ref[DUALPOT_CH_QUAN];
+static u32 pinsSeen;                    /* port at the last sample */
+static u32 streamTick;                  /* ticks into the stream */
+static u32 skippedSeen;                 /* IsrSkipped at the last sample */
+static bool overrunSeen;                /* rollovers passed since the last call */
+static bool steppedSeen;                /* the last call stepped */
+static u32 overrunShare;                /* percent of commands that are overruns */
+static u32 seed = 1U;
+
+/* trace ring of the last ticks */
+typedef struct {
+    u32 Tick;
+    u32 Pins;
+    u8 Wiper[DUALPOT_CH_QUAN];
+    u8 Tap[DUALPOT_CH_QUAN];
+    u8 State[DUALPOT_CH_QUAN];
+} traceT;
+
+static traceT trace[CHECK_TRACE];
+static u32 traceQuan;                   /* entries written */
+
+static u32 randomNext(void){
+    seed = seed * 1103515245U + 12345U;
+    return seed >> 8;
+}
+
+static u64 nowNs(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+static bool fail(checkFailT *Fail, u8 Check, u8 Idx, const char *Text){
+
+    Fail->Check = Check;
+    Fail->Channel = (u8)(chA + Idx);
+    Fail->Tick = streamTick;
+    snprintf(Fail->Text, sizeof(Fail->Text), "tick %u ch%u %s: %s", streamTick, chA + Idx,
+             checkName[Check], Text);
+    return False;
+}
+
+static u32 distance(u8 A, u8 B){
+
+    return (A > B) ? (u32)(A - B) : (u32)(B - A);
+}
+
+/* pulses of a resync due after DUALPOT_RESYNC_PULSES, as specified */
+static u32 resyncPulses(u8 Tap, u8 End){
+    u32 pulses = distance(Tap, End) + (u32)DUALPOT_RESYNC_MARGIN;
+
+    return (pulses > (u32)(FULL_TAP - MIN_TAP)) ? (u32)(FULL_TAP - MIN_TAP) : pulses;
+}
+
+/* latest tick the channel may complete on, from now */
+static void boundSet(refChT *Ch){
+    u32 steps = distance(Ch->Wiper, Ch->Target);
+
+    if(True == Ch->Resync){
+        steps = (Ch->ResyncPlanned - Ch->ResyncDone) + distance(Ch->End, Ch->Target);
+    }
+    Ch->Bound = streamTick + 2U * steps + CHECK_SLACK;
+}
+
+#if (0 != DUALPOT_PIN_BUDGET)
+/* another channel is moving and shares the pin budget */
+static bool othersMoving(u8 Idx){
+    u8 idx;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if((Idx != idx) && (True == ref[idx].InFlight)){
+            return True;
+        }
+    }
+    return False;
+}
+#endif
+
+/* tap the driver takes the wiper to be at: during a resync it counts from
+ * a start the planned pulses away from the end stop */
+static u8 believed(const refChT *Ch){
+
+    if(True == Ch->Resync){
+        if(MIN_TAP == Ch->End){
+            return (u8)(MIN_TAP + Ch->ResyncPlanned - Ch->ResyncDone);
+        }
+        return (u8)(FULL_TAP - Ch->ResyncPlanned + Ch->ResyncDone);
+    }
+    return Ch->Wiper;
+}
+
+static void resyncStart(refChT *Ch, u32 Planned){
+    u8 cur = believed(Ch);
+
+    Ch->Resync = True;
+    Ch->End = (cur <= (u8)(FULL_TAP - cur)) ? (u8)MIN_TAP : (u8)FULL_TAP;
+    Ch->ResyncPlanned = Planned;
+    Ch->ResyncDone = 0U;
+    Ch->InFlight = True;
+}
+
+/* the ISR took the pending command at the start of this tick */
+static void refTake(refChT *Ch){
+
+    Ch->Pending = False;
+    if(True == Ch->PendFull){
+        resyncStart(Ch, (u32)(FULL_TAP - MIN_TAP));
+    }else if((False == Ch->Resync) && (False == Ch->InFlight) && (Ch->PendTap != Ch->Wiper)){
+        if(CHECK_RESYNC_DUE(Ch->Pulses)){
+            resyncStart(Ch, 0U);
+            Ch->ResyncPlanned = resyncPulses(Ch->Wiper, Ch->End);   /* the wiper is the believed tap at rest */
+        }else{
+            Ch->InFlight = True;
+        }
+    }/*ELSE: Do nothing, a retarget or no move*/
+    Ch->PendFull = False;
+    Ch->Target = Ch->PendTap;
+    boundSet(Ch);
+}
+
+/* one INC falling edge with the chip selected */
+static bool refEdge(refChT *Ch, u8 Idx, bool Up, checkFailT *Fail){
+    bool toEnd;
+
+    Ch->Pulses++;
+    if(True == Ch->Resync){
+        toEnd = (bool)(Up == (bool)(FULL_TAP == Ch->End));
+        if(True == toEnd){
+            Ch->ResyncDone++;
+            if(Ch->ResyncDone > Ch->ResyncPlanned){
+                return fail(Fail, CHECK_RESYNC, Idx, "more pulses into the end stop than planned");
+            }
+        }else{
+            if(Ch->Wiper != Ch->End){
+                return fail(Fail, CHECK_RESYNC, Idx, "turned before reaching the end stop");
+            }
+            Ch->Resync = False;             /* exact from here on */
+            Ch->Pulses = 1U;
+            boundSet(Ch);
+        }
+    }else{
+        if(Ch->Wiper == Ch->Target){
+            return fail(Fail, CHECK_DIRECTION, Idx, "stepped beyond the target");
+        }
+        if(Up != (bool)(Ch->Target > Ch->Wiper)){
+            return fail(Fail, CHECK_DIRECTION, Idx, "stepped away from the target");
+        }
+    }
+
+    if(True == Up){
+        if(FULL_TAP > Ch->Wiper){
+            Ch->Wiper++;
+        }
+    }else{
+        if(MIN_TAP < Ch->Wiper){
+            Ch->Wiper--;
+        }
+    }
+    return True;
+}
+
+static void traceAdd(u32 Pins, const DualPotStatusT *Status){
+    traceT *t = &trace[traceQuan % CHECK_TRACE];
+    u8 idx;
+
+    t->Tick = streamTick;
+    t->Pins = Pins;
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        t->Wiper[idx] = ref[idx].Wiper;
+        t->Tap[idx] = Status->Ch[idx].CurrTap;
+        t->State[idx] = Status->Ch[idx].State;
+    }
+    traceQuan++;
+}
+
+/* one timer tick of driver and reference; False on a failed check */
+static bool tick(checkFailT *Fail){
+    DualPotStatusT status;
+    DualPotStatsT stats;
+    u32 ticks = HAL_REGS->TimerTicks;
+    u32 pins;
+    u32 was;
+    bool stepped;                       /* the handler ran and stepped the channels */
+    bool incFall;
+    bool csWas;
+    bool csNow;
+    refChT *ch;
+    u8 idx;
+
+    PeriodicSimRun(1U);
+    DualPotDrv_GetStatus(&status);      /* as the ISR left it, before the bottom half runs */
+    DualPotDrv_Deferred();
+    streamTick++;
+    pins = HAL_REGS->PinOut;
+    was = pinsSeen;
+    pinsSeen = pins;
+    traceAdd(pins, &status);
+    DualPotDrv_GetStats(&stats);
+    stepped = (bool)((ticks != HAL_REGS->TimerTicks) && (skippedSeen == stats.IsrSkipped));
+    skippedSeen = stats.IsrSkipped;
+
+    if((True == overrunSeen) && (ticks != HAL_REGS->TimerTicks)){
+        overrunSeen = False;
+        if((True == steppedSeen) && (pins != was)){
+            return fail(Fail, CHECK_OVERRUN, 0U, "port changed by the call after an overrun");
+        }
+    }
+    steppedSeen = stepped;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        ch = &ref[idx];
+        if((True == stepped) && (True == ch->Pending)){
+            refTake(ch);                    /* cmdTake runs first in the handler */
+        }
+        if((ticks != HAL_REGS->TimerTicks) && (False == stepped)){
+            ch->Bound++;                    /* a call skipped after overruns */
+        }
+
+        csWas = (bool)(0UL != (was & (1UL << (PinCSA + idx))));
+        csNow = (bool)(0UL != (pins & (1UL << (PinCSA + idx))));
+        incFall = (bool)((0UL != (was & (1UL << (PinINCA + idx)))) && (0UL == (pins & (1UL << (PinINCA + idx)))));
+
+        if(True == incFall){
+            if((True == csWas) || (True == csNow)){
+                return fail(Fail, CHECK_INC_CS, idx, "INC fell without the chip selected since the tick before");
+            }
+            if(0UL != ((was ^ pins) & (1UL << (PinUDA + idx)))){
+                return fail(Fail, CHECK_UD_SETUP, idx, "U/D changed in the tick INC fell");
+            }
+            if(False == refEdge(ch, idx, (bool)(0UL != (pins & (1UL << (PinUDA + idx)))), Fail)){
+                return False;
+            }
+        }
+        if((True == csWas) && (False == csNow) && (False == ch->InFlight)){
+            return fail(Fail, CHECK_SELECT, idx, "chip selected with no move taken");
+        }
+        if((False == csWas) && (True == csNow)){
+            if(0UL == (pins & (1UL << (PinINCA + idx)))){
+                return fail(Fail, CHECK_CS_RISE, idx, "chip released with INC low");
+            }
+            if((True == ch->Resync) && (ch->End == ch->Target)){
+                ch->Resync = False;         /* the target was the end stop */
+                ch->Pulses = 0U;
+            }
+            if((True == ch->Resync) || (ch->Wiper != ch->Target)){
+                return fail(Fail, CHECK_STOP, idx, "chip released away from the target");
+            }
+            ch->InFlight = False;
+        }
+
+        if(status.Ch[idx].CurrTap != believed(ch)){
+            return fail(Fail, CHECK_TAP, idx, (True == ch->Resync) ? "driver tap differs from the resync count" :
+                                                                      "driver tap differs from the wiper");
+        }
+        if((False == ch->InFlight) && (False == ch->Pending) &&
+           (((u8)Stop != status.Ch[idx].State) && ((u8)Initial != status.Ch[idx].State))){
+            return fail(Fail, CHECK_STATE, idx, "idle channel not reported stopped");
+        }
+#if (0 != DUALPOT_PIN_BUDGET)
+        /* the budget may hold a move back, even its stop, while another
+         * channel moves: only ticks the channel has it alone count */
+        if(True == othersMoving(idx)){
+            ch->Bound++;
+        }/*ELSE: Do nothing*/
+#endif
+        if((True == ch->InFlight) && (False == ch->Pending) && (streamTick > ch->Bound)){
+            return fail(Fail, CHECK_LATE, idx, "move not complete in two ticks per step plus setup");
+        }
+    }
+    return True;
+}
+
+/* hand one command to the driver and the reference */
+static bool command(const checkCmdT *Cmd, checkFailT *Fail){
+    refChT *ch = &ref[Cmd->Channel - chA];
+    bool done;
+    u8 idx;
+
+    if(CHECK_OP_OVERRUN == Cmd->Op){
+        if(0UL != (HAL_REGS->TimerCtrl & HAL_TIMER_RUN)){
+            PeriodicSimOverrun(Cmd->Tap);
+            overrunSeen = True;
+        }/*ELSE: Do nothing, a stopped timer loses no rollovers*/
+        return True;
+    }
+    if(CHECK_OP_RESYNC == Cmd->Op){
+        (void)DualPotDrv_Resync(Cmd->Channel);
+        ch->Pending = True;
+        ch->PendFull = True;
+        ch->PendTap = ch->Requested;
+        return True;
+    }
+
+    ch->Requested = Cmd->Tap;
+    if((False == ch->InFlight) && (False == ch->Pending) && (False == ch->Resync) && (Cmd->Tap == ch->Wiper)){
+        ch->Target = Cmd->Tap;              /* already there, the driver publishes nothing */
+    }else{
+        if(False == ch->Pending){
+            ch->PendFull = False;
+        }/*ELSE: Do nothing, a resync not taken yet stays one*/
+        ch->Pending = True;
+        ch->PendTap = Cmd->Tap;
+    }
+
+    done = DualPotDrv_MainTap(Cmd->Channel, Cmd->Tap, Cmd->Deadline);
+    if(True == done){
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            if((True == ref[idx].InFlight) || (True == ref[idx].Pending) || (ref[idx].Wiper != ref[idx].Target)){
+                return fail(Fail, CHECK_DONE, idx, "DualPotDrv_MainTap reported every channel stopped");
+            }
+        }
+    }
+    return True;
+}
+
+/* one stream from a cold start; True if every check passed */
+static bool run(const checkCmdT *Cmd, u32 Quan, checkFailT *Fail){
+    DualPotStatsT stats;
+    u32 i;
+    u32 t;
+    u8 idx;
+    bool busy;
+
+    DualPotDrv_Init();
+    memset(ref, 0, sizeof(ref));
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        ref[idx].Wiper = MID_TAP;
+        ref[idx].Target = MID_TAP;
+        ref[idx].Requested = MID_TAP;
+    }
+    pinsSeen = HAL_REGS->PinOut;
+    DualPotDrv_GetStats(&stats);
+    skippedSeen = stats.IsrSkipped;
+    overrunSeen = False;
+    steppedSeen = False;
+    streamTick = 0U;
+    traceQuan = 0U;
+    Fail->Check = CHECK_PASS;
+
+    for(i = 0U; i < Quan; i++){
+        for(t = 0U; t < Cmd[i].Gap; t++){
+            if(False == tick(Fail)){
+                return False;
+            }
+        }
+        if(False == command(&Cmd[i], Fail)){
+            return False;
+        }
+    }
+
+    /* let the last moves complete, the bounds stop a stuck one */
+    do{
+        if(False == tick(Fail)){
+            return False;
+        }
+        busy = False;
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            busy = (bool)(busy || (True == ref[idx].InFlight) || (True == ref[idx].Pending));
+        }
+    }while(True == busy);
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if(ref[idx].Wiper != ref[idx].Requested){
+            return fail(Fail, CHECK_STOP, idx, "stream ended away from the last request");
+        }
+    }
+    return True;
+}
+
+/* random stream: mostly moves, near or far, a few resyncs and deadlines */
+static void generate(checkCmdT *Cmd, u32 Quan){
+    u8 last[DUALPOT_CH_QUAN];
+    u32 r;
+    u32 i;
+    u8 idx;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        last[idx] = MID_TAP;
+    }
+    for(i = 0U; i < Quan; i++){
+        r = randomNext() % 8U;
+        Cmd[i].Gap = (r < 3U) ? 0U : ((r < 6U) ? (randomNext() % 8U) : (randomNext() % 600U));
+        Cmd[i].Channel = (u8)(chA + (randomNext() % DUALPOT_CH_QUAN));
+        idx = (u8)(Cmd[i].Channel - chA);
+        Cmd[i].Op = (0U == (randomNext() % 24U)) ? (u8)CHECK_OP_RESYNC : (u8)CHECK_OP_MOVE;
+        if((randomNext() % 100U) < overrunShare){
+            Cmd[i].Op = (u8)CHECK_OP_OVERRUN;
+            Cmd[i].Channel = (u8)chA;
+            Cmd[i].Tap = (u8)(1U + (randomNext() % 3U));
+            Cmd[i].Deadline = 0U;
+            continue;
+        }
+        r = randomNext() % 8U;
+        if(r < 3U){
+            Cmd[i].Tap = (u8)(randomNext() % (FULL_TAP + 1U));
+        }else if(r < 6U){
+            Cmd[i].Tap = (u8)((s32)last[idx] + (s32)(randomNext() % 17U) - 8);   /* wraps at the ends too */
+        }else if(r < 7U){
+            Cmd[i].Tap = (0U == (randomNext() % 2U)) ? (u8)MIN_TAP : (u8)FULL_TAP;
+        }else{
+            Cmd[i].Tap = last[idx];
+        }
+        Cmd[i].Deadline = (0U == (randomNext() % 4U)) ? (randomNext() % 600U) : 0U;
+        if(CHECK_OP_MOVE == Cmd[i].Op){
+            last[idx] = Cmd[i].Tap;
+        }
+    }
+}
+
+/* drop commands and shorten gaps while the stream fails the same check */
+static u32 shrink(checkCmdT *Cmd, u32 Quan, checkFailT *Fail){
+    static checkCmdT tryCmd[CHECK_COMMANDS_MAX];
+    checkFailT tryFail;
+    u32 chunk;
+    u32 at;
+    u32 i;
+    u32 gap;
+    bool smaller = True;
+
+    while(True == smaller){
+        smaller = False;
+        for(chunk = Quan / 2U; chunk >= 1U; chunk /= 2U){
+            at = 0U;
+            while(at < Quan){
+                i = (at + chunk < Quan) ? chunk : (Quan - at);
+                memcpy(tryCmd, Cmd, at * sizeof(*Cmd));
+                memcpy(tryCmd + at, Cmd + at + i, (Quan - at - i) * sizeof(*Cmd));
+                if((False == run(tryCmd, Quan - i, &tryFail)) && (tryFail.Check == Fail->Check)){
+                    memcpy(Cmd, tryCmd, (Quan - i) * sizeof(*Cmd));
+                    Quan -= i;
+                    *Fail = tryFail;
+                    smaller = True;
+                }else{
+                    at += i;
+                }
+            }
+        }
+        for(i = 0U; i < Quan; i++){
+            for(gap = 0U; gap < Cmd[i].Gap; gap = (0U == gap) ? 1U : gap * 2U){
+                memcpy(tryCmd, Cmd, Quan * sizeof(*Cmd));
+                tryCmd[i].Gap = gap;
+                if((False == run(tryCmd, Quan, &tryFail)) && (tryFail.Check == Fail->Check)){
+                    Cmd[i].Gap = gap;
+                    *Fail = tryFail;
+                    smaller = True;
+                    break;
+                }
+            }
+            if(0U != Cmd[i].Deadline){
+                memcpy(tryCmd, Cmd, Quan * sizeof(*Cmd));
+                tryCmd[i].Deadline = 0U;
+                if((False == run(tryCmd, Quan, &tryFail)) && (tryFail.Check == Fail->Check)){
+                    Cmd[i].Deadline = 0U;
+                    *Fail = tryFail;
+                    smaller = True;
+                }
+            }
+        }
+    }
+    return Quan;
+}
+
+/* repro lines: gap move|resync|overrun channel tap|rollovers deadline */
+static void reproPrint(const checkCmdT *Cmd, u32 Quan){
+    u32 i;
+
+    for(i = 0U; i < Quan; i++){
+        printf("%u %s %u %u %u\n", Cmd[i].Gap, opName[Cmd[i].Op], Cmd[i].Channel, Cmd[i].Tap, Cmd[i].Deadline);
+    }
+}
+
+static u32 reproRead(const char *Path, checkCmdT *Cmd){
+    char op[16];
+    unsigned gap;
+    unsigned channel;
+    unsigned tap;
+    unsigned deadline;
+    u32 quan = 0U;
+    FILE *f;
+
+    f = fopen(Path, "r");
+    if(0 == f){
+        perror(Path);
+        return 0U;
+    }
+    while((quan < CHECK_COMMANDS_MAX) &&
+          (5 == fscanf(f, "%u %15s %u %u %u", &gap, op, &channel, &tap, &deadline))){
+        if(((chA > channel) || (channel >= (chA + DUALPOT_CH_QUAN))) || (tap > FULL_TAP)){
+            fprintf(stderr, "%s: command %u out of range\n", Path, quan + 1U);
+            (void)fclose(f);
+            return 0U;
+        }
+        Cmd[quan].Gap = gap;
+        Cmd[quan].Op = (u8)CHECK_OP_MOVE;
+        if(0 == strcmp(op, opName[CHECK_OP_RESYNC])){
+            Cmd[quan].Op = (u8)CHECK_OP_RESYNC;
+        }else if(0 == strcmp(op, opName[CHECK_OP_OVERRUN])){
+            Cmd[quan].Op = (u8)CHECK_OP_OVERRUN;
+        }/*ELSE: Do nothing*/
+        Cmd[quan].Channel = (u8)channel;
+        Cmd[quan].Tap = (u8)tap;
+        Cmd[quan].Deadline = deadline;
+        quan++;
+    }
+    (void)fclose(f);
+    return quan;
+}
+
+/* the last ticks before the failure */
+static void tracePrint(void){
+    const traceT *t;
+    u32 i = (traceQuan > CHECK_TRACE) ? (traceQuan - CHECK_TRACE) : 0U;
+    u8 idx;
+
+    printf("tick  port  wiper/driver tap/state per channel\n");
+    for(; i < traceQuan; i++){
+        t = &trace[i % CHECK_TRACE];
+        printf("%5u  0x%02X", t->Tick, t->Pins);
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            printf("  %3u/%3u/%u", t->Wiper[idx], t->Tap[idx], t->State[idx]);
+        }
+        printf("\n");
+    }
+}
+
+static void report(const checkCmdT *Cmd, u32 Quan, const checkFailT *Fail){
+    checkFailT again;
+
+    printf("%s\n", Fail->Text);
+    printf("repro, %u commands (gap move|resync|overrun channel tap|rollovers deadline):\n", Quan);
+    reproPrint(Cmd, Quan);
+    (void)run(Cmd, Quan, &again);          /* trace of the repro itself */
+    tracePrint();
+}
+
+int main(int argc, char *argv[]) {
+    static checkCmdT cmd[CHECK_COMMANDS_MAX];
+    checkFailT failure;
+    const char *reproPath = 0;
+    u64 streams = CHECK_STREAMS;
+    u64 s;
+    u64 begin;
+    u64 ticks = 0U;
+    u32 quan = CHECK_COMMANDS;
+    u32 streamSeed;
+    int opt;
+
+    while(-1 != (opt = getopt(argc, argv, "n:l:s:r:o:"))){
+        switch(opt){
+        case 'n':
+            streams = strtoull(optarg, 0, 10);
+            break;
+        case 'l':
+            quan = (u32)strtoul(optarg, 0, 10);
+            break;
+        case 's':
+            seed = (u32)strtoul(optarg, 0, 10);
+            break;
+        case 'r':
+            reproPath = optarg;
+            break;
+        case 'o':
+            overrunShare = (u32)strtoul(optarg, 0, 10);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n streams] [-l commands] [-s seed] [-o percent]\n       %s -r repro\n",
+                    argv[0], argv[0]);
+            return 2;
+        }
+    }
+    if((0U == quan) || (quan > CHECK_COMMANDS_MAX)){
+        fprintf(stderr, "-l: 1 to %u commands\n", CHECK_COMMANDS_MAX);
+        return 2;
+    }
+
+    if(0 != reproPath){
+        quan = reproRead(reproPath, cmd);
+        if(0U == quan){
+            return 2;
+        }
+        if(True == run(cmd, quan, &failure)){
+            printf("repro passes, %u ticks\n", streamTick);
+            return 0;
+        }
+        printf("%s\n", failure.Text);
+        tracePrint();
+        return 1;
+    }
+
+    begin = nowNs();
+    for(s = 0U; s < streams; s++){
+        streamSeed = seed;
+        generate(cmd, quan);
+        if(False == run(cmd, quan, &failure)){
+            printf("stream %llu (seed %u) failed\n", (unsigned long long)s, streamSeed);
+            quan = shrink(cmd, quan, &failure);
+            report(cmd, quan, &failure);
+            return 1;
+        }
+        ticks += streamTick;
+    }
+    printf("%llu streams of %u commands, %llu ticks in %.1f s: engine and reference agree\n",
+           (unsigned long long)streams, quan, (unsigned long long)ticks, (double)(nowNs() - begin) / 1e9);
+    return 0;
+}
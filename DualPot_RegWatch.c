@@ -0,0 +1,119 @@
+/*H**********************************************************************
+* FILENAME : DualPot_RegWatch.c
+* DESCRIPTION : Observer for the memory mapped register file
+* NOTES : Maps the register file written by a REGFILE build read-only and
+*         prints every change of the GPIO port register together with the
+*         timer tick it happened on. Reads go straight to the shared
+*         mapping, the driver process is never paused.
+*         usage: DualPot_RegWatch [register file]
+*         Stops on Ctrl-C and prints edge counts per pin.
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#include "Pin.h"
+#include "HalRegFile.h"
+
+static const char *const pinName[PinQuan] = {"CSA", "CSB", "UDA", "UDB", "INCA", "INCB"};
+
+static volatile sig_atomic_t stopReq = 0;
+
+static void pause1ms(void){
+    const struct timespec ts = {0, 1000000L};
+    (void)nanosleep(&ts, 0);
+}
+
+static void onSignal(int Sig){
+    (void)Sig;
+    stopReq = 1;
+}
+
+static void printPins(u32 Ticks, u32 PinOut){
+    u8 pin;
+
+    printf("tick %10u ", Ticks);
+    for(pin = 0U; pin < (u8)PinQuan; pin++){
+        printf(" %s=%u", pinName[pin], (PinOut >> pin) & 1U);
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+    const HalRegFileT *regFile;
+    const char *path = HAL_REGFILE_PATH;
+    u32 edges[PinQuan] = {0U};
+    u32 last;
+    u32 now;
+    u32 diff;
+    u8 pin;
+    int fd;
+
+    if(argc > 1){
+        path = argv[1];
+    }else{
+        if((0 != getenv(HAL_REGFILE_ENV)) && ('\0' != getenv(HAL_REGFILE_ENV)[0])){
+            path = getenv(HAL_REGFILE_ENV);
+        }
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    /* the driver creates the file when it initializes */
+    fd = open(path, O_RDONLY);
+    while((fd < 0) && (0 == stopReq)){
+        pause1ms();
+        fd = open(path, O_RDONLY);
+    }
+    if(fd < 0){
+        perror(path);
+        return 1;
+    }
+    regFile = (const HalRegFileT *)mmap(0, sizeof(HalRegFileT), PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if(MAP_FAILED == (const void *)regFile){
+        perror(path);
+        return 1;
+    }
+
+    /* wait for the driver to publish a valid register block */
+    while((0 == stopReq) && (HAL_REGFILE_MAGIC != regFile->Magic)){
+        pause1ms();
+    }
+    if(HAL_REGFILE_VERSION != regFile->Version){
+        fprintf(stderr, "%s: register file version %u, expected %lu\n", path, regFile->Version, HAL_REGFILE_VERSION);
+        return 1;
+    }
+
+    printf("watching %s, driver pid %u\n", path, regFile->WriterPid);
+    last = regFile->Regs.PinOut;
+    printPins(regFile->Regs.TimerTicks, last);
+
+    while(0 == stopReq){
+        now = regFile->Regs.PinOut;
+        if(now != last){
+            diff = now ^ last;
+            for(pin = 0U; pin < (u8)PinQuan; pin++){
+                if(0U != ((diff >> pin) & 1U)){
+                    edges[pin]++;
+                }
+            }
+            printPins(regFile->Regs.TimerTicks, now);
+            last = now;
+        }
+    }
+
+    printf("edges:");
+    for(pin = 0U; pin < (u8)PinQuan; pin++){
+        printf(" %s=%u", pinName[pin], edges[pin]);
+    }
+    printf("\n");
+    return 0;
+}
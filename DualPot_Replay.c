@@ -0,0 +1,413 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Replay.c
+* DESCRIPTION : Replays recorded setpoint logs through the DualPot driver
+* NOTES : Streams a DualPot_Log.h setpoint log into DualPotDrv_Main on the
+*         simulated timer, at the recorded pace scaled by -s or, by
+*         default, as fast as possible. The log is mapped a window at a
+*         time, so files far larger than RAM replay in bounded memory.
+*         Simulated time stands still between records only while no move
+*         is under way; idle gaps are skipped. Reports the throughput and
+*         per channel settle times: ticks from a request until the
+*         completion callback of its move.
+*         Samples the port and the timer after every simulated tick and
+*         charges each request with the pin toggles of its channel, the
+*         ticks its chip select stays asserted and a share of the ISR
+*         wakeups, until the next request of the channel; -e sets the
+*         energy per toggle, per asserted tick and per wakeup, -a writes
+*         one line per request.
+*         usage: DualPot_Replay [-s speed] [-e toggle,cs,wakeup nJ] [-a csv] log
+*                DualPot_Replay -g records log   (write a synthetic log)
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#define _FILE_OFFSET_BITS 64
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "DualPot_Drv.h"
+#include "DualPot_Sim.h"
+#include "HalRegs.h"
+
+#define REPLAY_WINDOW     (64UL << 20)  /* bytes of the log mapped at a time */
+#define REPLAY_REC_MAX    4096U         /* largest RecSize accepted */
+#define REPLAY_TOGGLE_NJ  0.2           /* default energy of a pin toggle: a pad and trace at 3.3 V */
+#define REPLAY_CS_NJ      0.5           /* default energy of a tick with the chip selected */
+#define REPLAY_WAKEUP_NJ  30.0          /* default energy of an ISR wakeup of the MCU */
+
+/* switching activity of one request, or summed over a channel's */
+typedef struct {
+    u64 Cs;                             /* CS toggles */
+    u64 Ud;                             /* U/D toggles */
+    u64 Inc;                            /* INC toggles */
+    u64 CsTicks;                        /* ticks that ended with CS asserted */
+    double Wakeups;                     /* handler calls, shared by the requests in flight */
+} activityT;
+
+typedef struct {
+    activityT Sum;                      /* all requests of the channel */
+    u64 Requests;                       /* requests charged */
+    double Nj;                          /* their energy */
+    double MaxNj;                       /* costliest request */
+} energyStatsT;
+
+static DualPotSimT sim;
+static DualPotSimSettleT settle[DUALPOT_CH_QUAN];
+static u64 rejected;                    /* records failing the range check */
+
+static double toggleNj = REPLAY_TOGGLE_NJ;
+static double csNj = REPLAY_CS_NJ;
+static double wakeupNj = REPLAY_WAKEUP_NJ;
+static FILE *acctFile;                  /* per request lines, 0 for none */
+static u64 handed;                      /* records handed to request() */
+static bool charged[DUALPOT_CH_QUAN];   /* a request is charged with the channel's activity */
+static u64 chargedRec[DUALPOT_CH_QUAN]; /* its record number */
+static activityT activity[DUALPOT_CH_QUAN]; /* its activity so far */
+static energyStatsT energy[DUALPOT_CH_QUAN];
+static double idleWakeups;              /* handler calls with no request in flight */
+static u32 pinsSeen;                    /* port at the last sample */
+static u32 timerSeen;                   /* TimerTicks at the last sample */
+
+static u64 nowNs(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+/* completion callback: settle time of the pending request */
+static void onDone(u8 Channel, u8 Tap){
+
+    (void)Tap;
+    DualPotSim_Done(&sim, Channel);
+}
+
+/* charge the channels with what the port and the timer did since the last
+ * sample; a wakeup is shared by the channels awaiting their move */
+static void sample(void *Ctx){
+    u32 pins = HAL_REGS->PinOut;
+    u32 flips = pins ^ pinsSeen;
+    u32 wakeups = HAL_REGS->TimerTicks - timerSeen;
+    u32 inFlight = 0U;
+    activityT *act;
+    u8 idx;
+
+    (void)Ctx;
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if(True == sim.Pending[idx]){
+            inFlight++;
+        }
+    }
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        act = &activity[idx];
+        act->Cs += (flips >> (PinCSA + idx)) & 1UL;
+        act->Ud += (flips >> (PinUDA + idx)) & 1UL;
+        act->Inc += (flips >> (PinINCA + idx)) & 1UL;
+        if(0UL == (pins & (1UL << (PinCSA + idx)))){
+            act->CsTicks++;
+        }
+        if(True == sim.Pending[idx]){
+            act->Wakeups += (double)wakeups / (double)inFlight;
+        }
+    }
+    if(0U == inFlight){
+        idleWakeups += (double)wakeups;
+    }
+    pinsSeen = pins;
+    timerSeen = HAL_REGS->TimerTicks;
+}
+
+static double energyNj(const activityT *Act){
+
+    return (double)(Act->Cs + Act->Ud + Act->Inc) * toggleNj + (double)Act->CsTicks * csNj +
+           Act->Wakeups * wakeupNj;
+}
+
+/* close the account of the request charged on a channel */
+static void charge(u8 Idx){
+    energyStatsT *stats = &energy[Idx];
+    const activityT *act = &activity[Idx];
+    double nj;
+
+    if(True == charged[Idx]){
+        nj = energyNj(act);
+        stats->Sum.Cs += act->Cs;
+        stats->Sum.Ud += act->Ud;
+        stats->Sum.Inc += act->Inc;
+        stats->Sum.CsTicks += act->CsTicks;
+        stats->Sum.Wakeups += act->Wakeups;
+        stats->Requests++;
+        stats->Nj += nj;
+        if(nj > stats->MaxNj){
+            stats->MaxNj = nj;
+        }
+        if(0 != acctFile){
+            fprintf(acctFile, "%llu,%u,%llu,%llu,%llu,%llu,%.2f,%.2f\n", (unsigned long long)chargedRec[Idx],
+                    chA + Idx, (unsigned long long)act->Cs, (unsigned long long)act->Ud,
+                    (unsigned long long)act->Inc, (unsigned long long)act->CsTicks, act->Wakeups, nj);
+        }
+    }
+    memset(&activity[Idx], 0, sizeof(activity[Idx]));
+    charged[Idx] = False;
+}
+
+/* hand one record to the driver */
+static void request(const DualPotLogRecT *Rec){
+    u8 idx;
+
+    handed++;
+    if(False == DualPotSim_Valid(Rec)){
+        rejected++;
+        (void)DualPotDrv_Main(Rec->Channel, Rec->Resistance);  /* counted by the driver too */
+        return;
+    }
+
+    idx = (u8)(Rec->Channel - chA);
+    charge(idx);                            /* what follows is this request's */
+    charged[idx] = True;
+    chargedRec[idx] = handed - 1U;
+    DualPotSim_Request(&sim, Rec);
+}
+
+static void report(u64 Records, u64 Bytes, u64 WallNs){
+    DualPotStatsT stats;
+    const DualPotSimSettleT *ch;
+    double wallS = (double)WallNs / 1e9;
+    double simS = (double)sim.Tick / (double)TIMER_FREQ;
+    double tickUs = 1e6 / (double)TIMER_FREQ;
+    u8 idx;
+
+    printf("records %llu (%.1f MiB) in %.3f s: %.0f records/s, %.1f MiB/s\n",
+           (unsigned long long)Records, (double)Bytes / 1048576.0, wallS,
+           (double)Records / wallS, (double)Bytes / 1048576.0 / wallS);
+    printf("simulated %.1f s, %.1fx real time, %llu rejected\n",
+           simS, simS / wallS, (unsigned long long)rejected);
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        ch = &settle[idx];
+        printf("ch%u  moves %llu  no move %llu  superseded %llu\n", idx,
+               (unsigned long long)ch->Moves, (unsigned long long)ch->NoMove,
+               (unsigned long long)ch->Superseded);
+        if(0U != ch->Moves){
+            printf("     settle ticks  mean %.1f  p50 %llu  p99 %llu  max %llu  (max %.0f us)\n",
+                   (double)ch->SumTicks / (double)ch->Moves,
+                   (unsigned long long)DualPotSim_Percentile(ch, 0.50),
+                   (unsigned long long)DualPotSim_Percentile(ch, 0.99),
+                   (unsigned long long)ch->MaxTicks, (double)ch->MaxTicks * tickUs);
+        }
+    }
+
+    DualPotDrv_GetStats(&stats);
+    printf("isr %u  events lost %u\n", stats.IsrCount, stats.EventsLost);
+
+    printf("energy at %.2f nJ per toggle, %.2f nJ per CS tick, %.2f nJ per wakeup\n",
+           toggleNj, csNj, wakeupNj);
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if(0U != energy[idx].Requests){
+            printf("ch%u  toggles cs %llu  ud %llu  inc %llu  cs ticks %llu  wakeups %.0f\n", idx,
+                   (unsigned long long)energy[idx].Sum.Cs, (unsigned long long)energy[idx].Sum.Ud,
+                   (unsigned long long)energy[idx].Sum.Inc, (unsigned long long)energy[idx].Sum.CsTicks,
+                   energy[idx].Sum.Wakeups);
+            printf("     %.3f mJ  per request mean %.1f nJ  max %.1f nJ\n", energy[idx].Nj / 1e6,
+                   energy[idx].Nj / (double)energy[idx].Requests, energy[idx].MaxNj);
+        }
+    }
+    printf("wakeups with no request in flight %.0f (%.3f mJ)\n", idleWakeups, idleWakeups * wakeupNj / 1e6);
+}
+
+static int replay(const char *Path, double Speed){
+    DualPotLogHdrT hdr;
+    DualPotLogRecT rec;
+    struct stat st;
+    struct timespec due;
+    const u8 *map;
+    u64 records;
+    u64 i = 0U;
+    u64 off;
+    u64 winOff;
+    u64 winLen;
+    u64 page = (u64)sysconf(_SC_PAGESIZE);
+    u64 wall0;
+    u64 dueNs;
+    u64 firstUs = 0U;
+    u8 idx;
+    int fd;
+
+    fd = open(Path, O_RDONLY);
+    if(fd < 0){
+        perror(Path);
+        return 1;
+    }
+    if((0 != fstat(fd, &st)) || ((ssize_t)sizeof(hdr) != pread(fd, &hdr, sizeof(hdr), 0))){
+        fprintf(stderr, "%s: no log header\n", Path);
+        (void)close(fd);
+        return 1;
+    }
+    if((DUALPOT_LOG_MAGIC != hdr.Magic) || (DUALPOT_LOG_VERSION != hdr.Version) ||
+       (hdr.RecSize < sizeof(rec)) || (hdr.RecSize > REPLAY_REC_MAX)){
+        fprintf(stderr, "%s: not a version %lu setpoint log\n", Path, DUALPOT_LOG_VERSION);
+        (void)close(fd);
+        return 1;
+    }
+    records = ((u64)st.st_size - sizeof(hdr)) / hdr.RecSize;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        sim.Settle[idx] = &settle[idx];
+    }
+    sim.Sample = sample;
+    DualPotDrv_Init();
+    DualPotDrv_SetDoneCallback(onDone);
+    pinsSeen = HAL_REGS->PinOut;            /* levels Init left, not charged */
+    timerSeen = HAL_REGS->TimerTicks;
+    if(0 != acctFile){
+        fprintf(acctFile, "record,channel,cs,ud,inc,cs_ticks,wakeups,nj\n");
+    }
+    wall0 = nowNs();
+
+    while(i < records){
+
+        /* window from the page holding record i on, whole records only */
+        off = sizeof(hdr) + i * hdr.RecSize;
+        winOff = off - (off % page);
+        winLen = (u64)st.st_size - winOff;
+        if(winLen > REPLAY_WINDOW){
+            winLen = REPLAY_WINDOW;
+        }
+        map = (const u8 *)mmap(0, (size_t)winLen, PROT_READ, MAP_PRIVATE, fd, (off_t)winOff);
+        if(MAP_FAILED == (const void *)map){
+            perror("mmap");
+            (void)close(fd);
+            return 1;
+        }
+        (void)posix_madvise((void *)map, (size_t)winLen, POSIX_MADV_SEQUENTIAL);
+
+        while((i < records) && ((off + hdr.RecSize) <= (winOff + winLen))){
+            memcpy(&rec, map + (off - winOff), sizeof(rec));   /* records need not be aligned */
+            if(0U == i){
+                firstUs = rec.TimeUs;
+            }
+
+            /* recorded pace, scaled */
+            if((Speed > 0.0) && (rec.TimeUs > firstUs)){
+                dueNs = wall0 + (u64)((double)(rec.TimeUs - firstUs) * 1000.0 / Speed);
+                if(dueNs > nowNs()){
+                    due.tv_sec = (time_t)(dueNs / 1000000000ULL);
+                    due.tv_nsec = (long)(dueNs % 1000000000ULL);
+                    (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, 0);
+                }
+            }
+
+            if(rec.TimeUs > firstUs){
+                DualPotSim_Advance(&sim, (rec.TimeUs - firstUs) * (u64)TIMER_FREQ / 1000000ULL);
+            }
+            request(&rec);
+            i++;
+            off += hdr.RecSize;
+        }
+        (void)munmap((void *)map, (size_t)winLen);
+    }
+    (void)close(fd);
+
+    /* let the last moves complete */
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        while(True == sim.Pending[idx]){
+            DualPotSim_Advance(&sim, sim.Tick + 1U);
+        }
+    }
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        charge(idx);
+    }
+
+    report(records, (u64)st.st_size, nowNs() - wall0);
+    DualPotDrv_DeInit();
+    return 0;
+}
+
+/* synthetic log, the profile of DualPot_Fleet's first board */
+static int generate(const char *Path, u64 Records){
+    DualPotLogHdrT hdr;
+    DualPotLogRecT rec;
+    DualPotSimGenT gen;
+    u64 i;
+    FILE *f;
+
+    f = fopen(Path, "wb");
+    if(0 == f){
+        perror(Path);
+        return 1;
+    }
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.Magic = DUALPOT_LOG_MAGIC;
+    hdr.Version = DUALPOT_LOG_VERSION;
+    hdr.RecSize = sizeof(rec);
+    (void)fwrite(&hdr, sizeof(hdr), 1U, f);
+
+    DualPotSimGen_Init(&gen, 1U);
+    for(i = 0U; i < Records; i++){
+        DualPotSimGen_Next(&gen, &rec);
+        if(1U != fwrite(&rec, sizeof(rec), 1U, f)){
+            perror(Path);
+            (void)fclose(f);
+            return 1;
+        }
+    }
+    return (0 == fclose(f)) ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    double speed = 0.0;                     /* 0: as fast as possible */
+    const char *acctPath = 0;
+    const char *genRecords = 0;
+    int rc;
+    int opt;
+
+    while(-1 != (opt = getopt(argc, argv, "s:e:a:g:"))){
+        switch(opt){
+        case 's':
+            speed = atof(optarg);
+            break;
+        case 'e':
+            if(3 != sscanf(optarg, "%lf,%lf,%lf", &toggleNj, &csNj, &wakeupNj)){
+                fprintf(stderr, "-e wants toggle,cs,wakeup energies in nJ\n");
+                return 2;
+            }
+            break;
+        case 'a':
+            acctPath = optarg;
+            break;
+        case 'g':
+            genRecords = optarg;
+            break;
+        default:
+            optind = argc + 1;              /* usage */
+            break;
+        }
+    }
+    if((optind + 1) != argc){
+        fprintf(stderr, "usage: %s [-s speed] [-e toggle,cs,wakeup nJ] [-a csv] log\n"
+                        "       %s -g records log\n", argv[0], argv[0]);
+        return 2;
+    }
+    if(0 != genRecords){
+        return generate(argv[optind], (u64)strtoull(genRecords, 0, 10));
+    }
+
+    if(0 != acctPath){
+        acctFile = fopen(acctPath, "w");
+        if(0 == acctFile){
+            perror(acctPath);
+            return 1;
+        }
+    }
+    rc = replay(argv[optind], speed);
+    if((0 != acctFile) && (0 != fclose(acctFile))){
+        perror(acctPath);
+        rc = 1;
+    }
+    return rc;
+}
@@ -0,0 +1,251 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Sim.c
+* DESCRIPTION : Settle accounting and synthetic setpoints for the host tools
+* PUBLIC FUNCTIONS :
+*           void DualPotSim_Done(DualPotSimT *sim, u8 channel)
+*           bool DualPotSim_Busy(const DualPotSimT *sim)
+*           void DualPotSim_Advance(DualPotSimT *sim, u64 tick)
+*           bool DualPotSim_Valid(const DualPotLogRecT *rec)
+*           void DualPotSim_Request(DualPotSimT *sim, const DualPotLogRecT *rec)
+*           u64 DualPotSim_Percentile(const DualPotSimSettleT *settle, double quantile)
+*           void DualPotSim_SettleMerge(DualPotSimSettleT *sum, const DualPotSimSettleT *part)
+*           void DualPotSimGen_Init(DualPotSimGenT *gen, u32 seed)
+*           void DualPotSimGen_Next(DualPotSimGenT *gen, DualPotLogRecT *rec)
+* NOTES : Shared by DualPot_Replay and DualPot_Fleet, built into each
+*         against the driver library it links (DualPotDrv or the thread
+*         local DualPotDrvFleet). Needs the simulated timer (PeriodicSim.h).
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   Moved out of DualPot_Replay.c and DualPot_Fleet.c
+*H***********************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include <string.h>
+#include "DualPot_Sim.h"
+#include "PeriodicSim.h"
+
+/******************************************************************************
+ *	local functions
+ ******************************************************************************/
+static u32 randomNext(u32 *Seed);
+
+/********************************************************************
+* FUNCTION   : void DualPotSim_Done(DualPotSimT *sim, u8 channel)
+* PURPOSE    : Record the settle time of the pending request of a channel
+* PARAMETERS : DualPotSimT *sim     //instance the callback reports on
+*              u8 channel           //channel whose move completed
+* RETURN     : void
+* NOTE       : call from the completion callback
+**********************************************************************/
+void DualPotSim_Done(DualPotSimT *sim, u8 channel){
+    u8 idx = (u8)(channel - chA);
+    DualPotSimSettleT *settle = sim->Settle[idx];
+    u64 ticks;
+
+    if(True == sim->Pending[idx]){
+        ticks = sim->Tick - sim->ReqTick[idx];
+        settle->Hist[(ticks < DUALPOT_SIM_SETTLE_MAX) ? ticks : DUALPOT_SIM_SETTLE_MAX]++;
+        settle->Moves++;
+        settle->SumTicks += ticks;
+        if(ticks > settle->MaxTicks){
+            settle->MaxTicks = ticks;
+        }/*ELSE: Do nothing*/
+        sim->Pending[idx] = False;
+    }/*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : bool DualPotSim_Busy(const DualPotSimT *sim)
+* PURPOSE    : Tell whether a request awaits its move
+* PARAMETERS : const DualPotSimT *sim
+* RETURN     : bool
+**********************************************************************/
+bool DualPotSim_Busy(const DualPotSimT *sim){
+    bool busy = False;
+    u8 idx;
+
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        busy = (bool)(busy || (True == sim->Pending[idx]));
+    }
+    return busy;
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotSim_Advance(DualPotSimT *sim, u64 tick)
+* PURPOSE    : Advance simulated time to a tick
+* PARAMETERS : DualPotSimT *sim
+*              u64 tick             //simulated time to reach
+* RETURN     : void
+* NOTE       : ticks run one at a time while a request awaits its move,
+*              each followed by the Sample hook and the bottom half; the
+*              timer is stopped otherwise, so the rest is skipped
+**********************************************************************/
+void DualPotSim_Advance(DualPotSimT *sim, u64 tick){
+
+    while(sim->Tick < tick){
+        if(True == DualPotSim_Busy(sim)){
+            PeriodicSimRun(1U);
+            sim->Tick++;
+            sim->Ran++;
+            if(0 != sim->Sample){
+                sim->Sample(sim->Ctx);
+            }/*ELSE: Do nothing*/
+            DualPotDrv_Deferred();
+        }else{
+            sim->Tick = tick;               /* timer stopped, nothing to simulate */
+        }
+    }
+}
+
+/********************************************************************
+* FUNCTION   : bool DualPotSim_Valid(const DualPotLogRecT *rec)
+* PURPOSE    : Range check of a record, as DualPotDrv_Main does it
+* PARAMETERS : const DualPotLogRecT *rec
+* RETURN     : bool
+**********************************************************************/
+bool DualPotSim_Valid(const DualPotLogRecT *rec){
+
+    return (bool)(((chA == rec->Channel) || (chB == rec->Channel)) &&
+                  (rec->Resistance >= MIN_RESISTANCE) && (rec->Resistance <= MAX_RESISTANCE));
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotSim_Request(DualPotSimT *sim, const DualPotLogRecT *rec)
+* PURPOSE    : Hand a record to the driver and track its request
+* PARAMETERS : DualPotSimT *sim
+*              const DualPotLogRecT *rec    //passed DualPotSim_Valid
+* RETURN     : void
+* NOTE       : a request for the tap an idle channel holds completes
+*              without a move; one that replaces a pending request counts
+*              as superseding it
+**********************************************************************/
+void DualPotSim_Request(DualPotSimT *sim, const DualPotLogRecT *rec){
+    DualPotStatusT status;
+    DualPotSimSettleT *settle;
+    u8 idx = (u8)(rec->Channel - chA);
+    u8 tap;
+    bool idle;
+
+    settle = sim->Settle[idx];
+    DualPotDrv_GetStatus(&status);
+    (void)DualPotDrv_GetTapBatch(&rec->Resistance, &tap, 1U);
+    idle = (bool)((Initial == status.Ch[idx].State) || (Stop == status.Ch[idx].State));
+
+    (void)DualPotDrv_Main(rec->Channel, rec->Resistance);  /* may report the previous move */
+
+    if(True == sim->Pending[idx]){
+        settle->Superseded++;
+    }/*ELSE: Do nothing*/
+    if((True == idle) && (tap == status.Ch[idx].CurrTap)){
+        settle->NoMove++;
+        sim->Pending[idx] = False;
+    }else{
+        sim->ReqTick[idx] = sim->Tick;
+        sim->Pending[idx] = True;
+    }
+}
+
+/********************************************************************
+* FUNCTION   : u64 DualPotSim_Percentile(const DualPotSimSettleT *settle, double quantile)
+* PURPOSE    : Ticks until a quantile of the moves have settled
+* PARAMETERS : const DualPotSimSettleT *settle
+*              double quantile      //0..1
+* RETURN     : u64                  //DUALPOT_SIM_SETTLE_MAX if beyond the histogram
+**********************************************************************/
+u64 DualPotSim_Percentile(const DualPotSimSettleT *settle, double quantile){
+    u64 want = (u64)((double)settle->Moves * quantile + 0.999999);
+    u64 seen = 0U;
+    u32 bin;
+
+    for(bin = 0U; bin < DUALPOT_SIM_SETTLE_MAX; bin++){
+        seen += settle->Hist[bin];
+        if(seen >= want){
+            break;
+        }/*ELSE: Do nothing*/
+    }
+    return bin;
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotSim_SettleMerge(DualPotSimSettleT *sum, const DualPotSimSettleT *part)
+* PURPOSE    : Add settle statistics
+* PARAMETERS : DualPotSimSettleT *sum       //added to
+*              const DualPotSimSettleT *part
+* RETURN     : void
+**********************************************************************/
+void DualPotSim_SettleMerge(DualPotSimSettleT *sum, const DualPotSimSettleT *part){
+    u32 bin;
+
+    for(bin = 0U; bin <= DUALPOT_SIM_SETTLE_MAX; bin++){
+        sum->Hist[bin] += part->Hist[bin];
+    }
+    sum->Moves += part->Moves;
+    sum->NoMove += part->NoMove;
+    sum->Superseded += part->Superseded;
+    sum->SumTicks += part->SumTicks;
+    if(part->MaxTicks > sum->MaxTicks){
+        sum->MaxTicks = part->MaxTicks;
+    }/*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotSimGen_Init(DualPotSimGenT *gen, u32 seed)
+* PURPOSE    : Start a synthetic setpoint profile
+* PARAMETERS : DualPotSimGenT *gen
+*              u32 seed             //same seed, same profile
+* RETURN     : void
+**********************************************************************/
+void DualPotSimGen_Init(DualPotSimGenT *gen, u32 seed){
+    u8 idx;
+
+    gen->Seed = seed;
+    gen->TimeUs = 0U;
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        gen->Level[idx] = MAX_RESISTANCE / 2.0f;
+    }
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotSimGen_Next(DualPotSimGenT *gen, DualPotLogRecT *rec)
+* PURPOSE    : Next record of a synthetic setpoint profile
+* PARAMETERS : DualPotSimGenT *gen
+*              DualPotLogRecT *rec  //filled
+* RETURN     : void
+* NOTE       : 0.1 to 20 ms after the last record, one channel moves by
+*              up to 300 ohm, or jumps anywhere once in eight records
+**********************************************************************/
+void DualPotSimGen_Next(DualPotSimGenT *gen, DualPotLogRecT *rec){
+    u8 idx;
+
+    gen->TimeUs += 100U + (randomNext(&gen->Seed) % 20000U);
+    idx = (u8)(randomNext(&gen->Seed) % DUALPOT_CH_QUAN);
+    if(0U == (randomNext(&gen->Seed) % 8U)){
+        gen->Level[idx] = (f32)(randomNext(&gen->Seed) % 10001U);    /* jump */
+    }else{
+        gen->Level[idx] += (f32)((s32)(randomNext(&gen->Seed) % 601U) - 300);
+    }
+    if(gen->Level[idx] < MIN_RESISTANCE){
+        gen->Level[idx] = MIN_RESISTANCE;
+    }/*ELSE: Do nothing*/
+    if(gen->Level[idx] > MAX_RESISTANCE){
+        gen->Level[idx] = MAX_RESISTANCE;
+    }/*ELSE: Do nothing*/
+    memset(rec, 0, sizeof(*rec));
+    rec->TimeUs = gen->TimeUs;
+    rec->Channel = (u8)(chA + idx);
+    rec->Resistance = gen->Level[idx];
+}
+
+/********************************************************************
+* FUNCTION   : static u32 randomNext(u32 *Seed)
+* PURPOSE    : Linear congruential generator of the synthetic profiles
+* PARAMETERS : u32 *Seed            //state, advanced
+* RETURN     : u32                  //24 random bits
+**********************************************************************/
+static u32 randomNext(u32 *Seed){
+    *Seed = *Seed * 1103515245U + 12345U;
+    return *Seed >> 8;
+}
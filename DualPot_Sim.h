@@ -0,0 +1,88 @@
+/******************************************************************************/
+//	DualPot_Sim.h
+/******************************************************************************/
+
+#ifndef MOTIV_DUALPOT_SIM_H
+#define MOTIV_DUALPOT_SIM_H
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include "DualPot_Drv.h"
+#include "DualPot_Log.h"
+
+/******************************************************************************/
+//	macros
+/******************************************************************************/
+#define DUALPOT_SIM_SETTLE_MAX 1024U    /* settle histogram range in ticks, last bin open */
+
+/******************************************************************************/
+//	types
+/*
+	- settle accounting of the host tools that feed setpoints through the
+	  driver on the simulated timer (DualPot_Replay, DualPot_Fleet): the
+	  settle time of a request is the ticks until the completion callback
+	  of its move
+*/
+/******************************************************************************/
+typedef struct {
+    u64 Hist[DUALPOT_SIM_SETTLE_MAX + 1U];  /* moves by settle ticks */
+    u64 Moves;                          /* requests completed by a move */
+    u64 NoMove;                         /* requests already at their tap */
+    u64 Superseded;                     /* requests replaced before their move completed */
+    u64 SumTicks;                       /* settle ticks of all moves */
+    u64 MaxTicks;                       /* longest settle time */
+} DualPotSimSettleT;
+
+/* one driver instance on the simulated timer */
+typedef struct {
+    u64 Tick;                           /* simulated time in ticks */
+    u64 Ran;                            /* ticks actually run, idle gaps are skipped */
+    u64 ReqTick[DUALPOT_CH_QUAN];       /* tick of the request awaiting its move */
+    bool Pending[DUALPOT_CH_QUAN];      /* a request awaits its move */
+    DualPotSimSettleT *Settle[DUALPOT_CH_QUAN]; /* where each channel's requests count */
+    void (*Sample)(void *Ctx);          /* called after every tick, may be 0 */
+    void *Ctx;
+} DualPotSimT;
+
+/* synthetic setpoint profile: both channels random walking, with jumps
+ * and idle gaps */
+typedef struct {
+    u32 Seed;
+    u64 TimeUs;
+    f32 Level[DUALPOT_CH_QUAN];
+} DualPotSimGenT;
+
+/******************************************************************************/
+//	functions
+/******************************************************************************/
+
+/* record the settle time of the pending request of channel, for the
+ * completion callback */
+void DualPotSim_Done(DualPotSimT *sim, u8 channel);
+
+/* True while a request awaits its move */
+bool DualPotSim_Busy(const DualPotSimT *sim);
+
+/* advance simulated time to tick, skipping it while nothing moves */
+void DualPotSim_Advance(DualPotSimT *sim, u64 tick);
+
+/* True if rec passes the driver's range check */
+bool DualPotSim_Valid(const DualPotLogRecT *rec);
+
+/* hand a valid record to the driver and track its request */
+void DualPotSim_Request(DualPotSimT *sim, const DualPotLogRecT *rec);
+
+/* ticks until the quantile of the moves have settled */
+u64 DualPotSim_Percentile(const DualPotSimSettleT *settle, double quantile);
+
+/* add part to sum */
+void DualPotSim_SettleMerge(DualPotSimSettleT *sum, const DualPotSimSettleT *part);
+
+/* start a synthetic profile, both channels at half scale */
+void DualPotSimGen_Init(DualPotSimGenT *gen, u32 seed);
+
+/* next record of a synthetic profile */
+void DualPotSimGen_Next(DualPotSimGenT *gen, DualPotLogRecT *rec);
+
+#endif //MOTIV_DUALPOT_SIM_H
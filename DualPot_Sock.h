@@ -0,0 +1,74 @@
+/******************************************************************************/
+//	DualPot_Sock.h
+/******************************************************************************/
+
+#ifndef MOTIV_DUALPOT_SOCK_H
+#define MOTIV_DUALPOT_SOCK_H
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "Generic.h"
+
+/******************************************************************************/
+//	macros
+/******************************************************************************/
+#define DUALPOT_SOCK_NAME   "dualpotd.sock"         /* socket file in the runtime directory */
+#define DUALPOT_SOCK_DIR    "/run/dualpotd"         /* runtime directory without $XDG_RUNTIME_DIR */
+#define DUALPOT_SOCK_ENV    "DUALPOT_SOCK"          /* overrides the default path */
+#define DUALPOT_SOCK_MODE   0600                    /* socket file, owner only */
+
+/* DualPotReqMsgT.Op */
+#define DUALPOT_OP_SET      1U      /* move Channel to Resistance */
+
+/* DualPotRspMsgT.Result */
+#define DUALPOT_RSP_DONE        0U  /* the channel stopped at the requested tap */
+#define DUALPOT_RSP_SUPERSEDED  1U  /* a later request for the channel was served instead */
+#define DUALPOT_RSP_REJECTED    2U  /* unknown op or channel, resistance out of range */
+
+/******************************************************************************/
+//	types
+/*
+	- dualpotd protocol over a Unix stream socket: fixed size records in host
+	  byte order, requests from the client, one response per request
+	- responses come when the move ends, not in request order; Id matches
+	  them up and is chosen by the client
+*/
+/******************************************************************************/
+typedef struct {
+    u32 Id;                         /* echoed in the response */
+    f32 Resistance;                 /* requested resistance */
+    u8 Op;                          /* DUALPOT_OP_x */
+    u8 Channel;                     /* chA/chB as passed to DualPotDrv_Main */
+    u8 Reserved[2];
+} DualPotReqMsgT;
+
+typedef struct {
+    u32 Id;                         /* of the request answered */
+    u32 LatencyUs;                  /* from receipt to the response, in the daemon */
+    u8 Result;                      /* DUALPOT_RSP_x */
+    u8 Channel;
+    u8 Tap;                         /* tap the channel stopped at */
+    u8 Reserved;
+} DualPotRspMsgT;
+
+/******************************************************************************/
+//	functions
+/******************************************************************************/
+/* socket path when -s is not given: $DUALPOT_SOCK, else the socket in
+   $XDG_RUNTIME_DIR, else the one in DUALPOT_SOCK_DIR; Buf holds the result */
+static inline const char *DualPotSockPath(char *Buf, size_t Len){
+    const char *env = getenv(DUALPOT_SOCK_ENV);
+
+    if((0 != env) && ('\0' != env[0])){
+        return env;
+    }
+    env = getenv("XDG_RUNTIME_DIR");
+    (void)snprintf(Buf, Len, "%s/" DUALPOT_SOCK_NAME,
+                   ((0 != env) && ('/' == env[0])) ? env : DUALPOT_SOCK_DIR);
+    return Buf;
+}
+
+#endif //MOTIV_DUALPOT_SOCK_H
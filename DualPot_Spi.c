@@ -0,0 +1,254 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Spi.c
+* DESCRIPTION : SPI programmed potentiometer device for the DualPot driver
+* PUBLIC FUNCTIONS :
+*           const DualPotDevT DualPotDev_Spi
+* NOTES : Writes the requested tap straight into the wiper register with
+*         one SPI transaction, so every request completes on the call that
+*         makes it. No timer is used.
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   SPI device implementation
+* 0.1.1   18Oct2026   agent   Status snapshot
+* 0.1.2   18Oct2026   agent   Completion callback, empty bottom half
+* 0.1.3   18Oct2026   agent   Settle time, always zero ticks
+* 0.1.4   18Oct2026   agent   Request deadline accepted and ignored
+* 0.1.5   18Oct2026   agent   No trajectory mode
+* 0.1.6   18Oct2026   agent   Thread local wiper cache
+* 0.1.7   18Oct2026   agent   Resync rewrites the wiper register
+* 0.1.8   18Oct2026   agent   Wiper cache kept across a warm restart
+* 0.1.9   18Oct2026   agent   Cold init writes MID_TAP to every wiper
+*H***********************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include "DualPot_Dev.h"
+#include "Spi.h"
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+#define SPI_ADDR_SHIFT  4U                  /* address field of the command byte */
+#define SPI_CMD_WRITE   0x00U               /* write data command */
+
+static const u8 wiperAddr[DUALPOT_CH_QUAN] = {0x0U, 0x1U};  /* wiper address per channel */
+static SyncLocal u8 currTap[DUALPOT_CH_QUAN]; /* tap held by each wiper register */
+
+/******************************************************************************
+ *	local functions
+ ******************************************************************************/
+static void spiInit(const DualPotWarmT *warm);
+static bool spiMain(u8 channel, u8 tap, u32 deadline);
+static void spiDeInit(DualPotWarmT *warm);
+static void spiDeferred(void);
+static void spiSettle(u8 channel, const f32 *resistance, DualPotSettleT *settle, size_t n);
+static bool spiTrajStart(u8 channel);
+static size_t spiTrajQueue(u8 channel, const u8 *tap, const u32 *ticks, size_t n);
+static void spiTrajStop(u8 channel);
+static bool spiResync(u8 channel);
+static void wiperWrite(u8 idx, u8 tap);
+static void publishStatus(void);
+
+/******************************************************************************
+ *	device operations
+ ******************************************************************************/
+const DualPotDevT DualPotDev_Spi = {
+    spiInit,
+    spiMain,
+    spiDeInit,
+    spiDeferred,
+    spiSettle,
+    spiTrajStart,
+    spiTrajQueue,
+    spiTrajStop,
+    spiResync
+};
+
+/********************************************************************
+* FUNCTION   : static void spiInit(const DualPotWarmT *warm)
+* PURPOSE    : Initialize SPI device
+* PARAMETERS : const DualPotWarmT *warm //checked state of the last run, 0 for a cold start
+* RETURN     : void
+* NOTE       : a cold start writes MID_TAP to every wiper register, a
+*              restart without a power cycle may have left it anywhere
+**********************************************************************/
+static void spiInit(const DualPotWarmT *warm){
+    u8 idx;
+
+    SpiModuleInit();                        /* Initialize SPI module */
+
+    /* wiper registers keep their value while powered */
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        if(0 != warm){
+            currTap[idx] = warm->Tap[idx];
+        }else{
+            wiperWrite(idx, MID_TAP);
+        }
+    }
+    publishStatus();
+}
+
+/********************************************************************
+* FUNCTION   : static bool spiMain(u8 channel, u8 tap, u32 deadline)
+* PURPOSE    : Write the requested tap to the wiper register
+* PARAMETERS : u8 channel           //channel for tap setting, already range checked
+*              u8 tap               //desired tap value
+*              u32 deadline         //unused, the write completes the move at once
+* RETURN     : bool                 //always True, the write completes the move
+**********************************************************************/
+static bool spiMain(u8 channel, u8 tap, u32 deadline){
+    u8 idx = (u8)(channel - chA);
+
+    (void)deadline;
+
+    /* skip the transaction if the wiper already holds the tap */
+    if(tap != currTap[idx]){
+        wiperWrite(idx, tap);
+        publishStatus();
+        DualPotDone_Notify(channel, tap);
+    }
+    return True;
+}
+
+/********************************************************************
+* FUNCTION   : static void spiDeInit(DualPotWarmT *warm)
+* PURPOSE    : De-initialize SPI device
+* PARAMETERS : DualPotWarmT *warm   //state export, 0 for none
+* RETURN     : void
+**********************************************************************/
+static void spiDeInit(DualPotWarmT *warm){
+    u8 idx;
+
+    /* the wiper registers keep their value, nothing to release */
+    if(0 != warm){
+        for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+            warm->Tap[idx] = currTap[idx];
+        }
+    }/*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : static void spiDeferred(void)
+* PURPOSE    : Bottom half of the SPI device
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+static void spiDeferred(void){
+
+    /* every write completes inside spiMain, nothing is left over */
+}
+
+/********************************************************************
+* FUNCTION   : static void spiSettle(u8 channel, const f32 *resistance, DualPotSettleT *settle, size_t n)
+* PURPOSE    : Settle time of a setpoint sequence
+* PARAMETERS : u8 channel           //channel for tap setting, already range checked
+*              const f32 *resistance    //range checked setpoints
+*              DualPotSettleT *settle   //Ticks of each move
+*              size_t n             //number of setpoints
+* RETURN     : void
+**********************************************************************/
+static void spiSettle(u8 channel, const f32 *resistance, DualPotSettleT *settle, size_t n){
+    size_t i;
+
+    (void)channel;
+    (void)resistance;
+
+    /* the wiper register takes the tap within spiMain, no timer ticks */
+    for(i = 0U; i < n; i++){
+        settle[i].Ticks = 0U;
+    }
+}
+
+/********************************************************************
+* FUNCTION   : static bool spiTrajStart(u8 channel)
+* PURPOSE    : Trajectory mode, not supported
+* PARAMETERS : u8 channel           //channel for the trajectory
+* RETURN     : bool                 //always False, no timer to play points from
+**********************************************************************/
+static bool spiTrajStart(u8 channel){
+
+    (void)channel;
+    return False;
+}
+
+/********************************************************************
+* FUNCTION   : static size_t spiTrajQueue(u8 channel, const u8 *tap, const u32 *ticks, size_t n)
+* PURPOSE    : Trajectory mode, not supported
+* PARAMETERS : u8 channel           //channel for the trajectory
+*              const u8 *tap        //setpoints
+*              const u32 *ticks     //ticks each setpoint is held
+*              size_t n             //number of points
+* RETURN     : size_t               //always 0, nothing queued
+**********************************************************************/
+static size_t spiTrajQueue(u8 channel, const u8 *tap, const u32 *ticks, size_t n){
+
+    (void)channel;
+    (void)tap;
+    (void)ticks;
+    (void)n;
+    return 0U;
+}
+
+/********************************************************************
+* FUNCTION   : static void spiTrajStop(u8 channel)
+* PURPOSE    : Trajectory mode, not supported
+* PARAMETERS : u8 channel           //channel for the trajectory
+* RETURN     : void
+**********************************************************************/
+static void spiTrajStop(u8 channel){
+
+    (void)channel;
+}
+
+/********************************************************************
+* FUNCTION   : static bool spiResync(u8 channel)
+* PURPOSE    : Write the cached tap to the wiper register again
+* PARAMETERS : u8 channel           //channel to resync, already range checked
+* RETURN     : bool                 //always True, the write completes it
+* NOTE       : the register takes an absolute tap, a reset part is set
+*              right with one transaction
+**********************************************************************/
+static bool spiResync(u8 channel){
+    u8 idx = (u8)(channel - chA);
+
+    wiperWrite(idx, currTap[idx]);
+    DualPotDone_Notify(channel, currTap[idx]);
+    return True;
+}
+
+/********************************************************************
+* FUNCTION   : static void wiperWrite(u8 idx, u8 tap)
+* PURPOSE    : Write a tap to the wiper register, one SPI transaction
+* PARAMETERS : u8 idx               //channel index
+*              u8 tap               //tap to write
+* RETURN     : void
+**********************************************************************/
+static void wiperWrite(u8 idx, u8 tap){
+    u8 frame[2];
+
+    frame[0] = (u8)((wiperAddr[idx] << SPI_ADDR_SHIFT) | SPI_CMD_WRITE);
+    frame[1] = tap;
+    SpiTransfer(frame, 0, 2U);
+    currTap[idx] = tap;
+}
+
+/********************************************************************
+* FUNCTION   : static void publishStatus(void)
+* PURPOSE    : Publish the wiper registers for DualPotDrv_GetStatus
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+static void publishStatus(void){
+    DualPotStatusT *status = DualPotStatus_WriteBegin();
+    u8 idx;
+
+    status->Tick = 0U;                      /* no timer on this device */
+    for(idx = 0U; idx < DUALPOT_CH_QUAN; idx++){
+        status->Ch[idx].CurrTap = currTap[idx];
+        status->Ch[idx].TargetTap = currTap[idx];
+        status->Ch[idx].State = (u8)Stop;
+    }
+    DualPotStatus_WriteEnd();
+}
@@ -0,0 +1,105 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Stats.c
+* DESCRIPTION : Runtime performance counters of the DualPot driver
+* PUBLIC FUNCTIONS :
+*           void DualPotDrv_GetStats(DualPotStatsT *stats)
+*           void DualPotDrv_ClearStats(void)
+*           void DualPotStats_Attach(void)
+*           void DualPotStats_Detach(void)
+* NOTES : Counters live in a static DualPotStatsT on target. Host builds
+*         with DUALPOT_STATS_SHM place them in a POSIX shared memory
+*         region instead, so DualPot_StatsCli can read them while the
+*         driver runs. They move back to RAM at DeInit and on into a new
+*         region at the next Init, counting on. Every counter is a single u32 written by one
+*         context; a copy may mix counters of neighbouring ticks.
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   Performance counters
+* 0.1.1   18Oct2026   agent   Per thread counters for HAL_THREAD_LOCAL
+* 0.1.2   18Oct2026   agent   Shared memory region removed at DeInit
+*H***********************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include <string.h>
+#include "DualPot_Dev.h"
+#ifdef DUALPOT_STATS_SHM
+#include "DualPot_StatsShm.h"
+#endif
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+static SyncLocal DualPotStatsT statsRam;    /* counters until attached elsewhere */
+#ifdef HAL_THREAD_LOCAL
+SyncLocal DualPotStatsT *DualPotStats = 0;  /* set by DualPotStats_Attach, per thread addresses are not constant */
+#else
+DualPotStatsT *DualPotStats = &statsRam;
+#endif
+
+/********************************************************************
+* FUNCTION   : void DualPotStats_Attach(void)
+* PURPOSE    : Place the counters, shared memory on host builds
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+void DualPotStats_Attach(void){
+#ifdef HAL_THREAD_LOCAL
+    if(0 == DualPotStats){
+        DualPotStats = &statsRam;
+    }
+    /*ELSE: Do nothing*/
+#endif
+#ifdef DUALPOT_STATS_SHM
+    DualPotStatsT *shm = DualPotStatsShm_Attach(DualPotStats);
+
+    if(0 != shm){
+        DualPotStats = shm;
+    }
+    /*ELSE: Do nothing, keep counting in RAM*/
+#endif
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotStats_Detach(void)
+* PURPOSE    : Take the counters back to RAM, remove the shared memory
+* PARAMETERS : void
+* RETURN     : void
+* NOTE       : called by DualPotDrv_DeInit once the timer is stopped
+**********************************************************************/
+void DualPotStats_Detach(void){
+#ifdef DUALPOT_STATS_SHM
+    if((0 != DualPotStats) && (&statsRam != DualPotStats)){
+        statsRam = *(volatile DualPotStatsT *)DualPotStats;
+        DualPotStats = &statsRam;
+        DualPotStatsShm_Detach();
+    }
+    /*ELSE: Do nothing*/
+#endif
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotDrv_GetStats(DualPotStatsT *stats)
+* PURPOSE    : Copy the performance counters
+* PARAMETERS : DualPotStatsT *stats     //destination of the copy
+* RETURN     : void
+**********************************************************************/
+void DualPotDrv_GetStats(DualPotStatsT *stats){
+
+    if(0 != stats){
+        *stats = *(volatile DualPotStatsT *)DualPotStats;
+    }
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotDrv_ClearStats(void)
+* PURPOSE    : Reset all performance counters
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+void DualPotDrv_ClearStats(void){
+
+    memset((void *)DualPotStats, 0, sizeof(DualPotStatsT));
+}
@@ -0,0 +1,124 @@
+/*H**********************************************************************
+* FILENAME : DualPot_StatsCli.c
+* DESCRIPTION : Reader for the shared memory performance counters
+* NOTES : Maps the counters exported by a DUALPOT_STATS_SHM build of the
+*         driver read-only and prints them. Reads go straight to the
+*         shared mapping, the driver process is never paused.
+*         usage: DualPot_StatsCli [-p pid] [-w interval_ms]
+*         -p names the driver process, its region is
+*         DUALPOT_STATS_SHM_NAME.<pid>; $DUALPOT_STATS_SHM names the
+*         region instead. -w repeats the report every interval until
+*         Ctrl-C.
+* AUTHOR : agent         DATE : 18 Oct 2026
+*H***********************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "DualPot_StatsShm.h"
+
+static const char *const stateName[DUALPOT_STATE_QUAN] = {"Initial", "Setup1", "Setup2", "Running", "Stop"};
+
+static volatile sig_atomic_t stopReq = 0;
+
+static void pauseMs(long Ms){
+    struct timespec ts;
+
+    ts.tv_sec = Ms / 1000L;
+    ts.tv_nsec = (Ms % 1000L) * 1000000L;
+    (void)nanosleep(&ts, 0);
+}
+
+static void onSignal(int Sig){
+    (void)Sig;
+    stopReq = 1;
+}
+
+static void printStats(const DualPotStatsShmT *Shm){
+    DualPotStatsT stats;
+    u8 idx;
+    u8 state;
+
+    memcpy(&stats, (const void *)&Shm->Stats, sizeof(stats));
+
+    printf("pid %u  isr %u  isr max %u cycles  bad channel %u\n",
+           Shm->WriterPid, stats.IsrCount, stats.IsrMaxCycles, stats.RejectedChannel);
+    printf("  isr overruns %u  calls without a step %u\n", stats.IsrOverruns, stats.IsrSkipped);
+    for(idx = 0U; (idx < DUALPOT_CH_QUAN) && (idx < Shm->ChQuan); idx++){
+        printf("  ch%u  accepted %u  rejected %u  inc %u  reversals %u  resyncs %u\n", idx,
+               stats.Ch[idx].Accepted, stats.Ch[idx].Rejected,
+               stats.Ch[idx].IncPulses, stats.Ch[idx].Reversals, stats.Ch[idx].Resyncs);
+        printf("       deadline met %u  missed %u\n",
+               stats.Ch[idx].DeadlineMet, stats.Ch[idx].DeadlineMissed);
+        printf("       ticks");
+        for(state = 0U; state < DUALPOT_STATE_QUAN; state++){
+            printf(" %s=%u", stateName[state], stats.Ch[idx].StateTicks[state]);
+        }
+        printf("\n");
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[]) {
+    const DualPotStatsShmT *shm;
+    const char *env = getenv(DUALPOT_STATS_SHM_ENV);
+    long watchMs = 0L;
+    u32 pid = 0U;
+    int opt;
+
+    while(-1 != (opt = getopt(argc, argv, "p:w:"))){
+        switch(opt){
+        case 'p':
+            pid = (u32)strtoul(optarg, 0, 10);
+            break;
+        case 'w':
+            watchMs = atol(optarg);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-p pid] [-w interval_ms]\n", argv[0]);
+            return 2;
+        }
+    }
+    if((0U == pid) && ((0 == env) || ('\0' == env[0]))){
+        fprintf(stderr, "%s: give the driver process with -p or the region with $%s\n", argv[0],
+                DUALPOT_STATS_SHM_ENV);
+        return 2;
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    shm = DualPotStatsShm_Open(pid);
+    while((0 == shm) && (watchMs > 0L) && (0 == stopReq)){
+        pauseMs(watchMs);                   /* wait for the driver to create it */
+        shm = DualPotStatsShm_Open(pid);
+    }
+    if(0 == shm){
+        fprintf(stderr, "no performance counters exported\n");
+        return 1;
+    }
+
+    while((0 == stopReq) && (DUALPOT_STATS_SHM_MAGIC != shm->Magic) && (watchMs > 0L)){
+        pauseMs(watchMs);
+    }
+    if(DUALPOT_STATS_SHM_MAGIC != shm->Magic){
+        fprintf(stderr, "performance counters not initialized\n");
+        return 1;
+    }
+    if(DUALPOT_STATS_SHM_VERSION != shm->Version){
+        fprintf(stderr, "performance counter layout version %u, expected %lu\n",
+                shm->Version, DUALPOT_STATS_SHM_VERSION);
+        return 1;
+    }
+
+    printStats(shm);
+    while((watchMs > 0L) && (0 == stopReq)){
+        pauseMs(watchMs);
+        printStats(shm);
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+/*H**********************************************************************
+* FILENAME : DualPot_StatsShm.c
+* DESCRIPTION : Shared memory export of the performance counters
+* PUBLIC FUNCTIONS :
+*           DualPotStatsT *DualPotStatsShm_Attach(const DualPotStatsT *from)
+*           void DualPotStatsShm_Detach(void)
+*           const DualPotStatsShmT *DualPotStatsShm_Open(u32 pid)
+* NOTES : Host builds only. The driver process creates its own region,
+*         DUALPOT_STATS_SHM_NAME.<pid> (or $DUALPOT_STATS_SHM), with
+*         O_EXCL and updates the counters in place; readers map it
+*         read-only. A region left by a driver that died is reclaimed,
+*         one held by a live process is not shared: the second driver
+*         keeps counting in RAM. DeInit removes the object.
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   Performance counters in POSIX shared memory
+* 0.2.0   18Oct2026   agent   One region per driver process, created with
+*                             O_EXCL and removed at DeInit; readers check
+*                             the object size
+*H***********************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "DualPot_StatsShm.h"
+
+/******************************************************************************
+ *	local macros
+ ******************************************************************************/
+#define SHM_NAME_SIZE 64U                   /* object name with the pid */
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+static DualPotStatsShmT *statsShm = 0;      /* region owned by this process */
+static char statsName[SHM_NAME_SIZE];       /* its object name */
+
+/******************************************************************************
+ *	local functions
+ ******************************************************************************/
+static void shmName(u32 Pid, char *Name);
+static const DualPotStatsShmT *shmMap(const char *Name);
+static bool shmStale(const char *Name);
+
+/********************************************************************
+* FUNCTION   : DualPotStatsT *DualPotStatsShm_Attach(const DualPotStatsT *from)
+* PURPOSE    : Create the shared memory region, once per process
+* PARAMETERS : const DualPotStatsT *from    //counters to start from
+* RETURN     : DualPotStatsT *      //counters in the region, 0 on failure
+* NOTE       : fails if a live process holds the object
+**********************************************************************/
+DualPotStatsT *DualPotStatsShm_Attach(const DualPotStatsT *from){
+    void *map;
+    int fd;
+
+    if(0 != statsShm){
+        return &statsShm->Stats;            /* already attached */
+    }
+
+    shmName((u32)getpid(), statsName);
+    fd = shm_open(statsName, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if((fd < 0) && (EEXIST == errno) && (True == shmStale(statsName))){
+        (void)shm_unlink(statsName);        /* left by a driver that died */
+        fd = shm_open(statsName, O_RDWR | O_CREAT | O_EXCL, 0644);
+    }/*ELSE: Do nothing*/
+    if(fd < 0){
+        perror(statsName);
+        return 0;
+    }
+
+    if(0 != ftruncate(fd, (off_t)sizeof(DualPotStatsShmT))){
+        perror(statsName);
+        (void)close(fd);
+        (void)shm_unlink(statsName);
+        return 0;
+    }
+
+    map = mmap(0, sizeof(DualPotStatsShmT), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);                        /* the mapping keeps the object */
+    if(MAP_FAILED == map){
+        perror(statsName);
+        (void)shm_unlink(statsName);
+        return 0;
+    }
+
+    statsShm = (DualPotStatsShmT *)map;
+    statsShm->Magic = 0UL;                  /* invalid while the region is set up */
+    memcpy((void *)&statsShm->Stats, from, sizeof(statsShm->Stats));
+    statsShm->Version = DUALPOT_STATS_SHM_VERSION;
+    statsShm->WriterPid = (u32)getpid();
+    statsShm->ChQuan = DUALPOT_CH_QUAN;
+    __sync_synchronize();
+    statsShm->Magic = DUALPOT_STATS_SHM_MAGIC;
+    return &statsShm->Stats;
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotStatsShm_Detach(void)
+* PURPOSE    : Unmap the region and remove the object
+* PARAMETERS : void
+* RETURN     : void
+* NOTE       : readers that mapped it keep their copy of the last counters
+**********************************************************************/
+void DualPotStatsShm_Detach(void){
+
+    if(0 != statsShm){
+        statsShm->Magic = 0UL;              /* no longer updated */
+        (void)munmap((void *)statsShm, sizeof(DualPotStatsShmT));
+        (void)shm_unlink(statsName);
+        statsShm = 0;
+    }/*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : const DualPotStatsShmT *DualPotStatsShm_Open(u32 pid)
+* PURPOSE    : Map the region of a driver process read-only
+* PARAMETERS : u32 pid              //driver process, unused with $DUALPOT_STATS_SHM
+* RETURN     : const DualPotStatsShmT * //region, 0 if not created yet
+**********************************************************************/
+const DualPotStatsShmT *DualPotStatsShm_Open(u32 pid){
+    char name[SHM_NAME_SIZE];
+
+    shmName(pid, name);
+    return shmMap(name);
+}
+
+/********************************************************************
+* FUNCTION   : const DualPotStatsShmT *shmMap(const char *Name)
+* PURPOSE    : Map an object read-only
+* PARAMETERS : const char *Name     //object name
+* RETURN     : const DualPotStatsShmT * //region, 0 if missing or too small
+* NOTE       : an object shorter than the region would fault on access;
+*              it is still being created or not a counter region
+**********************************************************************/
+static const DualPotStatsShmT *shmMap(const char *Name){
+    struct stat st;
+    void *map;
+    int fd;
+
+    fd = shm_open(Name, O_RDONLY, 0);
+    if(fd < 0){
+        return 0;
+    }
+
+    if((0 != fstat(fd, &st)) || (st.st_size < (off_t)sizeof(DualPotStatsShmT))){
+        (void)close(fd);
+        return 0;
+    }
+
+    map = mmap(0, sizeof(DualPotStatsShmT), PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    return (MAP_FAILED == map) ? 0 : (const DualPotStatsShmT *)map;
+}
+
+/********************************************************************
+* FUNCTION   : bool shmStale(const char *Name)
+* PURPOSE    : Tell an object left by a driver that died
+* PARAMETERS : const char *Name     //object name
+* RETURN     : bool                 //True if its writer no longer runs
+**********************************************************************/
+static bool shmStale(const char *Name){
+    const DualPotStatsShmT *old = shmMap(Name);
+    bool stale = False;
+
+    if((0 != old) && (DUALPOT_STATS_SHM_MAGIC == old->Magic) &&
+       (0 != kill((pid_t)old->WriterPid, 0)) && (ESRCH == errno)){
+        stale = True;
+    }/*ELSE: Do nothing, in use or being set up*/
+    if(0 != old){
+        (void)munmap((void *)old, sizeof(DualPotStatsShmT));
+    }/*ELSE: Do nothing*/
+    return stale;
+}
+
+/********************************************************************
+* FUNCTION   : void shmName(u32 Pid, char *Name)
+* PURPOSE    : Name of the shared memory object of a driver process
+* PARAMETERS : u32 Pid              //driver process
+*              char *Name           //SHM_NAME_SIZE bytes, filled
+* RETURN     : void
+**********************************************************************/
+static void shmName(u32 Pid, char *Name){
+    const char *env = getenv(DUALPOT_STATS_SHM_ENV);
+
+    if((0 == env) || ('\0' == env[0])){
+        (void)snprintf(Name, SHM_NAME_SIZE, "%s.%u", DUALPOT_STATS_SHM_NAME, Pid);
+    }else{
+        (void)snprintf(Name, SHM_NAME_SIZE, "%s", env);
+    }
+}
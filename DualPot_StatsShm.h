@@ -0,0 +1,52 @@
+/******************************************************************************/
+//	DualPot_StatsShm.h
+/******************************************************************************/
+
+#ifndef MOTIV_DUALPOT_STATSSHM_H
+#define MOTIV_DUALPOT_STATSSHM_H
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include "DualPot_Drv.h"
+
+/******************************************************************************/
+//	macros
+/******************************************************************************/
+#define DUALPOT_STATS_SHM_MAGIC   0x53504444UL      /* "DDPS" */
+#define DUALPOT_STATS_SHM_VERSION 4UL
+
+/* shared memory object, DUALPOT_STATS_SHM_NAME.<pid> of the driver process.
+ * The environment variable DUALPOT_STATS_SHM_ENV names it instead */
+#define DUALPOT_STATS_SHM_NAME    "/dualpot_stats"
+#define DUALPOT_STATS_SHM_ENV     "DUALPOT_STATS_SHM"
+
+/******************************************************************************/
+//	types
+/******************************************************************************/
+
+/* layout of the shared memory region holding the performance counters */
+typedef struct {
+    volatile u32 Magic;             /* DUALPOT_STATS_SHM_MAGIC once Stats is valid */
+    u32 Version;                    /* DUALPOT_STATS_SHM_VERSION */
+    u32 WriterPid;                  /* process owning the driver */
+    u32 ChQuan;                     /* DUALPOT_CH_QUAN of the writer */
+    DualPotStatsT Stats;            /* counters, updated in place by the driver */
+} DualPotStatsShmT;
+
+/******************************************************************************/
+//	functions
+/******************************************************************************/
+
+/* driver side, create the region starting from the counters in from and
+ * return its counters (0 on failure) */
+DualPotStatsT *DualPotStatsShm_Attach(const DualPotStatsT *from);
+
+/* driver side, unmap the region and remove the object */
+void DualPotStatsShm_Detach(void);
+
+/* reader side, map the region of driver process pid read-only (0 if it
+ * does not exist) */
+const DualPotStatsShmT *DualPotStatsShm_Open(u32 pid);
+
+#endif //MOTIV_DUALPOT_STATSSHM_H
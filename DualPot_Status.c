@@ -0,0 +1,78 @@
+/*H**********************************************************************
+* FILENAME : DualPot_Status.c
+* DESCRIPTION : Lock-free status snapshot of the DualPot driver
+* PUBLIC FUNCTIONS :
+*           void DualPotDrv_GetStatus(DualPotStatusT *status)
+*           DualPotStatusT *DualPotStatus_WriteBegin(void)
+*           void DualPotStatus_WriteEnd(void)
+* NOTES : Sequence lock with one writer at a time: the MAX5389 ISR while
+*         the timer runs, the driver bottom half (DualPotDrv_Main/
+*         DualPotDrv_Deferred) while it is stopped. The writer never waits;
+*         a reader that overlaps a write retries, so polling as often as
+*         needed costs the ISR nothing and never masks interrupts.
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   Sequence locked status snapshot
+* 0.1.1   18Oct2026   agent   Written by the bottom half only
+* 0.1.2   18Oct2026   agent   Thread local snapshot
+* 0.1.3   18Oct2026   agent   Written by the ISR again while the timer runs
+*H***********************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include "DualPot_Dev.h"
+#include "Sync.h"
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+static SyncLocal u32 statusSeq;             /* odd while a write is in progress */
+static SyncLocal DualPotStatusT statusBuf;  /* last published snapshot */
+
+/********************************************************************
+* FUNCTION   : void DualPotDrv_GetStatus(DualPotStatusT *status)
+* PURPOSE    : Read a consistent snapshot of all channels
+* PARAMETERS : DualPotStatusT *status   //destination of the snapshot
+* RETURN     : void
+**********************************************************************/
+void DualPotDrv_GetStatus(DualPotStatusT *status){
+    u32 seqBegin;
+    u32 seqEnd;
+
+    if(0 == status){
+        return;
+    }
+
+    do{
+        seqBegin = SyncLoad(&statusSeq);
+        *status = statusBuf;
+        SyncFenceAcquire();                 /* copy completes before the sequence is re-read */
+        seqEnd = SyncLoadRelaxed(&statusSeq);
+    }while((0U != (seqBegin & 1U)) || (seqBegin != seqEnd));
+}
+
+/********************************************************************
+* FUNCTION   : DualPotStatusT *DualPotStatus_WriteBegin(void)
+* PURPOSE    : Open the snapshot for writing
+* PARAMETERS : void
+* RETURN     : DualPotStatusT *     //snapshot to fill
+**********************************************************************/
+DualPotStatusT *DualPotStatus_WriteBegin(void){
+
+    SyncStoreRelaxed(&statusSeq, statusSeq + 1U);
+    SyncFenceRelease();                     /* odd sequence is visible before the data changes */
+    return &statusBuf;
+}
+
+/********************************************************************
+* FUNCTION   : void DualPotStatus_WriteEnd(void)
+* PURPOSE    : Publish the snapshot
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+void DualPotStatus_WriteEnd(void){
+
+    SyncStore(&statusSeq, statusSeq + 1U);
+}
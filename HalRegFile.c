@@ -0,0 +1,81 @@
+/*H**********************************************************************
+* FILENAME : HalRegFile.c
+* DESCRIPTION : Memory mapped register file for the register level backend
+* PUBLIC FUNCTIONS :
+*           void HalRegFileAttach(void)
+* NOTES : Maps HalRegFileT from a file (HAL_REGFILE_PATH or the file named
+*         by $DUALPOT_REGFILE) and points HalRegsBase at its register
+*         block. Other processes map the same file read-only and watch
+*         the GPIO and timer registers while the driver runs.
+*         If the file cannot be mapped the RAM register image is kept.
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   Memory mapped register file
+*H***********************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "HalRegFile.h"
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+static HalRegFileT *regFile = 0;            /* mapped register file */
+
+/********************************************************************
+* FUNCTION   : void HalRegFileAttach(void)
+* PURPOSE    : Map the register file, once per process
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+void HalRegFileAttach(void){
+    const char *path;
+    void *map;
+    int fd;
+
+    if(0 != regFile){
+        return;                             /* already attached */
+    }
+
+    path = getenv(HAL_REGFILE_ENV);
+    if((0 == path) || ('\0' == path[0])){
+        path = HAL_REGFILE_PATH;
+    }
+
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    if(fd < 0){
+        perror(path);
+        return;
+    }
+
+    if(0 != ftruncate(fd, (off_t)sizeof(HalRegFileT))){
+        perror(path);
+        (void)close(fd);
+        return;
+    }
+
+    map = mmap(0, sizeof(HalRegFileT), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);                        /* the mapping keeps the file */
+    if(MAP_FAILED == map){
+        perror(path);
+        return;
+    }
+
+    regFile = (HalRegFileT *)map;
+    regFile->Magic = 0UL;                   /* invalid while the block is set up */
+    memset((void *)&regFile->Regs, 0, sizeof(regFile->Regs));
+    regFile->Version = HAL_REGFILE_VERSION;
+    regFile->WriterPid = (u32)getpid();
+    HalRegsBase = &regFile->Regs;
+    __sync_synchronize();
+    regFile->Magic = HAL_REGFILE_MAGIC;
+}
@@ -0,0 +1,43 @@
+/******************************************************************************/
+//	HalRegFile.h
+/******************************************************************************/
+#ifndef	HalRegFileIncluded
+#define HalRegFileIncluded
+/******************************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+
+#include	"Generic.h"
+#include	"HalRegs.h"
+
+/******************************************************************************/
+//	types
+/******************************************************************************/
+
+//	layout of the register file shared between the driver and observers
+typedef	struct
+{	volatile u32	Magic;			//	HAL_REGFILE_MAGIC once the register block is valid
+	u32				Version;		//	HAL_REGFILE_VERSION
+	u32				WriterPid;		//	process owning the driver
+	u32				Reserved;
+	HalRegsT		Regs;			//	register block, HalRegsBase points here
+}	HalRegFileT;
+
+/******************************************************************************/
+//	macros
+/******************************************************************************/
+
+#define	HAL_REGFILE_MAGIC	0x46525044UL		//	"DPRF"
+#define	HAL_REGFILE_VERSION	1UL
+
+//	register file path, overridden by the environment variable HAL_REGFILE_ENV
+#define	HAL_REGFILE_PATH	"/tmp/dualpot.regs"
+#define	HAL_REGFILE_ENV		"DUALPOT_REGFILE"
+
+/******************************************************************************/
+#endif  //  HalRegFileIncluded
+/******************************************************************************/
+//  end of HalRegFile.h
+/******************************************************************************/
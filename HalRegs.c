@@ -0,0 +1,138 @@
+/*H**********************************************************************
+* FILENAME : HalRegs.c
+* DESCRIPTION : Register level Pin/Periodic backend
+* PUBLIC FUNCTIONS :
+*           void PinPadWrite(PinT Pin, bool Value)
+*           void PinPadWriteMask(u32 Mask, u32 Value)
+*           void PinPadModuleInit(void)
+*           void Periodic...(...)           // full Periodic.h API
+*           void PeriodicSimRun(u32 Ticks)
+*           void PeriodicSimOverrun(u32 Ticks)
+*           void PinSimWatch(void (*Watch)(void))
+* NOTES : Drives the GPIO port and periodic timer through the HalRegsT
+*         register block. The register accesses live in HalRegs.h; this
+*         file provides them out of line for DUALPOT_HAL=REGS, and the
+*         register block and handler storage for both REGS and INLINE.
+*         Without HAL_REGS_ADDR the block is a plain RAM image on the host,
+*         or the register file mapped by HalRegFile.c (HAL_REGFILE).
+*         With HAL_THREAD_LOCAL every host thread has its own image.
+*         With HAL_THREAD the Periodic backend is HalThread.c instead.
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   Register level backend, inline HAL support
+* 0.2.0   18Oct2026   agent   Simulated timer, register file support
+* 0.3.0   18Oct2026   agent   Per thread register image and handler
+* 0.3.1   18Oct2026   agent   Pin backend only for the threaded timer
+* 0.3.2   18Oct2026   agent   Several pads in one port write
+* 0.3.3   18Oct2026   agent   Rollover count, simulated handler overruns
+* 0.3.4   18Oct2026   agent   Pad write observer for host checks
+*H***********************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include "Pin.h"
+#include "Periodic.h"
+#include "HalRegs.h"
+#include "PeriodicSim.h"
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+static HalRegsT halRegsRam;                 /* register image when not memory mapped */
+
+HalRegsT *HalRegsBase = &halRegsRam;        /* register block in use */
+#ifdef HAL_THREAD_LOCAL
+SyncLocal HalRegsT HalRegsLocal;            /* register image of each thread */
+#endif
+SyncLocal void (*HalPeriodicHandler)(void) = 0; /* handler registered by PeriodicConfig */
+
+#ifndef HAL_INLINE
+static SyncLocal void (*padWatch)(void) = 0;    /* called after every pad write */
+
+/******************************************************************************
+ *	out-of-line Pin backend
+ ******************************************************************************/
+void PinPadModuleInit(void)                     { HalPinModuleInit(); }
+
+void PinPadWrite(PinT Pin, bool Value){
+
+    HalPinWrite((u8)Pin, Value);
+    if(0 != padWatch){
+        padWatch();
+    }/*ELSE: Do nothing*/
+}
+
+void PinPadWriteMask(u32 Mask, u32 Value){
+
+    HalPinWriteMask(Mask, Value);
+    if(0 != padWatch){
+        padWatch();
+    }/*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : void PinSimWatch(void (*Watch)(void))
+* PURPOSE    : Observe every pad write
+* PARAMETERS : void (*Watch)(void)  //called after each write, 0 for none
+* RETURN     : void
+**********************************************************************/
+void PinSimWatch(void (*Watch)(void)){
+
+    padWatch = Watch;
+}
+#endif
+
+#if !defined(HAL_INLINE) && !defined(HAL_THREAD)
+/******************************************************************************
+ *	out-of-line Periodic backend
+ ******************************************************************************/
+void PeriodicModuleInit(void)                   { HalPeriodicModuleInit(); }
+void PeriodicConfig(f32 FreqHz, PeriodicHandlerT Handler) { HalPeriodicConfig(FreqHz, Handler); }
+void PeriodicStart(void)                        { HalPeriodicStart(); }
+void PeriodicStop(void)                         { HalPeriodicStop(); }
+void PeriodicIruptEnable(void)                  { HalPeriodicIruptEnable(); }
+void PeriodicIruptDisable(void)                 { HalPeriodicIruptDisable(); }
+void PeriodicIruptFlagClear(void)               { HalPeriodicIruptFlagClear(); }
+u32 PeriodicRollovers(void)                     { return HalPeriodicRollovers(); }
+#endif
+
+#ifndef HAL_THREAD
+/********************************************************************
+* FUNCTION   : void PeriodicSimRun(u32 Ticks)
+* PURPOSE    : Advance the simulated timer
+* PARAMETERS : u32 Ticks            //rollovers to simulate
+* RETURN     : void
+**********************************************************************/
+void PeriodicSimRun(u32 Ticks){
+
+    while(0U != Ticks){
+        Ticks--;
+
+        if(0UL != (HAL_REGS->TimerCtrl & HAL_TIMER_RUN)){
+            HAL_REGS->TimerTicks++;
+            HAL_REGS->TimerFlag = 1UL;              /* rollover interrupt pending */
+
+            if((0UL != (HAL_REGS->TimerCtrl & HAL_TIMER_IRUPT_EN)) && (0 != HalPeriodicHandler)){
+                HalPeriodicHandler();
+            }
+        }
+    }
+}
+
+/********************************************************************
+* FUNCTION   : void PeriodicSimOverrun(u32 Ticks)
+* PURPOSE    : Let rollovers pass without a handler call
+* PARAMETERS : u32 Ticks            //rollovers the last handler call overran
+* RETURN     : void
+* NOTE       : they count in TimerTicks; the flag they set was cleared by
+*              the late handler, so nothing is pending afterwards
+**********************************************************************/
+void PeriodicSimOverrun(u32 Ticks){
+
+    if(0UL != (HAL_REGS->TimerCtrl & HAL_TIMER_RUN)){
+        HAL_REGS->TimerTicks += Ticks;
+    }/*ELSE: Do nothing*/
+}
+#endif
@@ -0,0 +1,169 @@
+/******************************************************************************/
+//	HalRegs.h
+/******************************************************************************/
+#ifndef	HalRegsIncluded
+#define HalRegsIncluded
+/******************************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+
+#include	"Generic.h"
+#include	"Sync.h"
+
+/******************************************************************************/
+//	types
+/******************************************************************************/
+
+//	register block of the GPIO port and periodic timer
+typedef	struct
+{	volatile u32	PinOut;			//	output level, bit n drives PinT n
+	volatile u32	TimerCtrl;		//	HAL_TIMER_RUN | HAL_TIMER_IRUPT_EN
+	volatile u32	TimerReload;	//	timer clocks per rollover
+	volatile u32	TimerFlag;		//	rollover interrupt pending
+	volatile u32	TimerTicks;		//	rollovers since reset
+}	HalRegsT;
+
+/******************************************************************************/
+//	variables
+/******************************************************************************/
+
+//	register block location when HAL_REGS_ADDR is not fixed at build time
+extern	HalRegsT			*HalRegsBase;
+
+#ifdef	HAL_THREAD_LOCAL
+//	register image of the calling thread
+extern	SyncLocal	HalRegsT	HalRegsLocal;
+#endif
+
+//	handler registered by PeriodicConfig
+extern	SyncLocal	void		(*HalPeriodicHandler)(void);
+
+/******************************************************************************/
+//	service functions
+/******************************************************************************/
+
+#ifdef	HAL_REGFILE
+//	point HalRegsBase at the memory mapped register file (HalRegFile.c)
+void	HalRegFileAttach	(void);
+#endif
+
+/******************************************************************************/
+//	macros
+/******************************************************************************/
+
+#define	HAL_TIMER_RUN		(1UL << 0)
+#define	HAL_TIMER_IRUPT_EN	(1UL << 1)
+
+//	timer input clock
+#ifndef	HAL_TIMER_CLK_HZ
+#define	HAL_TIMER_CLK_HZ	((f32)16000000)
+#endif
+
+//	register block, a fixed address on target, a pointer on the host,
+//	one image per thread in the multi-instance host build
+#ifdef	HAL_REGS_ADDR
+#define	HAL_REGS			((HalRegsT *)(HAL_REGS_ADDR))
+#elif	defined(HAL_THREAD_LOCAL)
+#if		defined(HAL_REGFILE)
+#error	"HAL_THREAD_LOCAL gives every thread its own registers, not a shared register file"
+#endif
+#define	HAL_REGS			(&HalRegsLocal)
+#else
+#define	HAL_REGS			(HalRegsBase)
+#endif
+
+/******************************************************************************/
+//	register level functions
+/*
+	- shared by the out-of-line backend (HalRegs.c) and the header-inline HAL
+	  (HAL_INLINE), so both modes issue the same register accesses
+	- plain parameter types, this header is included from Pin.h and Periodic.h
+*/
+/******************************************************************************/
+
+static	inline	void	HalPinWrite		(u8 Pin, bool Value)
+{
+#ifdef	HAL_THREAD
+	//	set/clear register semantics, the timer thread writes the port concurrently
+	if	(Value)	(void)__atomic_fetch_or(&HAL_REGS->PinOut, (1UL << Pin), __ATOMIC_RELAXED);
+	else		(void)__atomic_fetch_and(&HAL_REGS->PinOut, ~(1UL << Pin), __ATOMIC_RELAXED);
+#else
+	if	(Value)	HAL_REGS->PinOut |= (1UL << Pin);
+	else		HAL_REGS->PinOut &= ~(1UL << Pin);
+#endif
+}
+
+static	inline	void	HalPinWriteMask	(u32 Mask, u32 Value)
+{
+#ifdef	HAL_THREAD
+	//	a clear and a set, each pad changes at most once
+	(void)__atomic_fetch_and(&HAL_REGS->PinOut, ~(Mask & ~Value), __ATOMIC_RELAXED);
+	(void)__atomic_fetch_or(&HAL_REGS->PinOut, (Mask & Value), __ATOMIC_RELAXED);
+#else
+	HAL_REGS->PinOut = (HAL_REGS->PinOut & ~Mask) | (Value & Mask);
+#endif
+}
+
+static	inline	void	HalPinModuleInit	(void)
+{
+#ifdef	HAL_REGFILE
+	HalRegFileAttach();
+#endif
+	HAL_REGS->PinOut = 0UL;
+}
+
+static	inline	void	HalPeriodicConfig	(f32 FreqHz, void (*Handler)(void))
+{
+	HAL_REGS->TimerCtrl = 0UL;
+	HAL_REGS->TimerReload = (u32)(HAL_TIMER_CLK_HZ / FreqHz + (f32)0.5);
+	HAL_REGS->TimerFlag = 0UL;
+	HalPeriodicHandler = Handler;
+}
+
+static	inline	void	HalPeriodicStart	(void)
+{
+	HAL_REGS->TimerCtrl |= HAL_TIMER_RUN;
+}
+
+static	inline	void	HalPeriodicStop		(void)
+{
+	HAL_REGS->TimerCtrl &= ~HAL_TIMER_RUN;
+}
+
+static	inline	void	HalPeriodicIruptEnable	(void)
+{
+	if	(HalPeriodicHandler)	HAL_REGS->TimerCtrl |= HAL_TIMER_IRUPT_EN;
+}
+
+static	inline	void	HalPeriodicIruptDisable	(void)
+{
+	HAL_REGS->TimerCtrl &= ~HAL_TIMER_IRUPT_EN;
+}
+
+static	inline	void	HalPeriodicIruptFlagClear	(void)
+{
+	HAL_REGS->TimerFlag = 0UL;
+}
+
+static	inline	u32		HalPeriodicRollovers	(void)
+{
+	return	HAL_REGS->TimerTicks;
+}
+
+static	inline	void	HalPeriodicModuleInit	(void)
+{
+#ifdef	HAL_REGFILE
+	HalRegFileAttach();
+#endif
+	HAL_REGS->TimerCtrl = 0UL;
+	HAL_REGS->TimerFlag = 0UL;
+	HAL_REGS->TimerTicks = 0UL;
+}
+
+/******************************************************************************/
+#endif  //  HalRegsIncluded
+/******************************************************************************/
+//  end of HalRegs.h
+/******************************************************************************/
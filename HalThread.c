@@ -0,0 +1,294 @@
+/*H**********************************************************************
+* FILENAME : HalThread.c
+* DESCRIPTION : Periodic backend running the handler on a real-time thread
+* PUBLIC FUNCTIONS :
+*           void Periodic...(...)           // full Periodic.h API
+*           void PeriodicThreadPlace(s32 Cpu, s32 Priority)
+*           void PeriodicThreadStats(PeriodicThreadStatsT *Stats)
+*           void PeriodicThreadExit(void)
+* NOTES : Host backend for DUALPOT_HAL=THREAD. The timer registers are the
+*         HalRegsT image of HalRegs.c; PeriodicConfig starts a POSIX
+*         thread which sleeps until every rollover with clock_nanosleep
+*         and, while the channel is started and its interrupt enabled,
+*         calls the handler, concurrently with the application.
+*         Rollovers that pass while the thread is late or still in the
+*         handler are lost like on a timer whose flag is still pending:
+*         they count in TimerTicks and Overruns but call nothing.
+*         PeriodicIruptDisable returns only once a handler call in
+*         progress has finished.
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   Threaded timer with jitter and overrun counts
+* 0.1.1   18Oct2026   agent   Rollover count
+*H***********************************************************************/
+#define _GNU_SOURCE
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "Periodic.h"
+#include "HalRegs.h"
+#include "PeriodicThread.h"
+#include "Sync.h"
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+static pthread_t timerThread;               /* runs the handler */
+static bool timerThreadOn = False;          /* timerThread was created and not joined */
+static u32 timerExit;                       /* asks timerThread to return */
+static u64 periodNs;                        /* rollover period, from the reload value */
+static s32 placeCpu = -1;                   /* core for timerThread, negative for any */
+static s32 placePriority = 0;               /* SCHED_FIFO priority, 0 for the default policy */
+static pthread_mutex_t isrLock = PTHREAD_MUTEX_INITIALIZER;    /* held while the handler runs */
+
+static u32 statsSeq;                        /* odd while the timer thread updates statsBuf */
+static PeriodicThreadStatsT statsBuf;       /* written by the timer thread only */
+
+/******************************************************************************
+ *	local functions
+ ******************************************************************************/
+static void *timerMain(void *Arg);
+static u64 nowNs(void);
+
+/********************************************************************
+* FUNCTION   : void PeriodicModuleInit(void)
+* PURPOSE    : Initialize the timer registers
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+void PeriodicModuleInit(void){
+
+    HalPeriodicModuleInit();
+}
+
+/********************************************************************
+* FUNCTION   : void PeriodicConfig(f32 FreqHz, PeriodicHandlerT Handler)
+* PURPOSE    : Set the rollover frequency and handler, start the thread
+* PARAMETERS : f32 FreqHz               //rollover frequency
+*              PeriodicHandlerT Handler //interrupt handler, 0 for none
+* RETURN     : void
+* NOTE       : the period is the one the reload value gives, as on target
+**********************************************************************/
+void PeriodicConfig(f32 FreqHz, PeriodicHandlerT Handler){
+    pthread_attr_t attr;
+    struct sched_param prio;
+    cpu_set_t cpus;
+    int err = -1;
+
+    HalPeriodicConfig(FreqHz, Handler);
+    periodNs = (u64)((double)HAL_REGS->TimerReload * 1e9 / (double)HAL_TIMER_CLK_HZ + 0.5);
+    if(0U == periodNs){
+        periodNs = 1U;
+    }
+
+    if(True == timerThreadOn){
+        return;                             /* the running thread picks up the new period */
+    }
+    memset(&statsBuf, 0, sizeof(statsBuf));
+    SyncStoreRelaxed(&timerExit, 0U);
+
+    pthread_attr_init(&attr);
+    if(0 <= placeCpu){
+        CPU_ZERO(&cpus);
+        CPU_SET((int)placeCpu, &cpus);
+        (void)pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+    }
+    if(0 < placePriority){
+        prio.sched_priority = (int)placePriority;
+        (void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        (void)pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        (void)pthread_attr_setschedparam(&attr, &prio);
+        err = pthread_create(&timerThread, &attr, timerMain, 0);
+        statsBuf.RealTime = (bool)(0 == err);
+    }
+    if(0 != err){
+        /* no real-time privilege or none asked for: default policy */
+        (void)pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+        err = pthread_create(&timerThread, &attr, timerMain, 0);
+    }
+    pthread_attr_destroy(&attr);
+
+    if(0 == err){
+        timerThreadOn = True;
+    }else{
+        fprintf(stderr, "PeriodicConfig: no timer thread (%s)\n", strerror(err));
+    }
+}
+
+void PeriodicStart(void)                        { HalPeriodicStart(); }
+void PeriodicStop(void)                         { HalPeriodicStop(); }
+void PeriodicIruptEnable(void)                  { HalPeriodicIruptEnable(); }
+void PeriodicIruptFlagClear(void)               { HalPeriodicIruptFlagClear(); }
+u32 PeriodicRollovers(void)                     { return HalPeriodicRollovers(); }
+
+/********************************************************************
+* FUNCTION   : void PeriodicIruptDisable(void)
+* PURPOSE    : Disable the rollover interrupt
+* PARAMETERS : void
+* RETURN     : void
+* NOTE       : waits for a handler call in progress, so the caller owns the
+*              handler's data on return as with a masked interrupt
+**********************************************************************/
+void PeriodicIruptDisable(void){
+
+    HalPeriodicIruptDisable();
+    if(True == timerThreadOn){
+        pthread_mutex_lock(&isrLock);
+        pthread_mutex_unlock(&isrLock);
+    }
+    /*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : void PeriodicThreadPlace(s32 Cpu, s32 Priority)
+* PURPOSE    : Choose core and priority of the timer thread
+* PARAMETERS : s32 Cpu                  //core, negative for any
+*              s32 Priority             //SCHED_FIFO priority, 0 for default
+* RETURN     : void
+**********************************************************************/
+void PeriodicThreadPlace(s32 Cpu, s32 Priority){
+
+    placeCpu = Cpu;
+    placePriority = Priority;
+}
+
+/********************************************************************
+* FUNCTION   : void PeriodicThreadStats(PeriodicThreadStatsT *Stats)
+* PURPOSE    : Read a consistent snapshot of the timer thread timing
+* PARAMETERS : PeriodicThreadStatsT *Stats  //destination of the snapshot
+* RETURN     : void
+**********************************************************************/
+void PeriodicThreadStats(PeriodicThreadStatsT *Stats){
+    u32 seqBegin;
+    u32 seqEnd;
+
+    if(0 == Stats){
+        return;
+    }
+
+    do{
+        seqBegin = SyncLoad(&statsSeq);
+        *Stats = statsBuf;
+        SyncFenceAcquire();                 /* copy completes before the sequence is re-read */
+        seqEnd = SyncLoadRelaxed(&statsSeq);
+    }while((0U != (seqBegin & 1U)) || (seqBegin != seqEnd));
+}
+
+/********************************************************************
+* FUNCTION   : void PeriodicThreadExit(void)
+* PURPOSE    : Stop and join the timer thread
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+void PeriodicThreadExit(void){
+
+    if(True == timerThreadOn){
+        SyncStore(&timerExit, 1U);
+        (void)pthread_join(timerThread, 0);
+        timerThreadOn = False;
+    }
+    /*ELSE: Do nothing*/
+}
+
+/********************************************************************
+* FUNCTION   : static void *timerMain(void *Arg)
+* PURPOSE    : Timer thread, one loop per rollover
+* PARAMETERS : void *Arg                //unused
+* RETURN     : void *                   //0
+**********************************************************************/
+static void *timerMain(void *Arg){
+    struct timespec due;
+    u64 dueNs = nowNs() + periodNs;
+    u64 wokeNs;
+    u64 doneNs;
+    u64 lateNs;
+    u64 handlerNs;
+    u64 lost;
+    bool run;
+    bool called;
+    u32 bucket;
+
+    (void)Arg;
+    while(0U == SyncLoad(&timerExit)){
+        due.tv_sec = (time_t)(dueNs / 1000000000ULL);
+        due.tv_nsec = (long)(dueNs % 1000000000ULL);
+        while(EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, 0)){
+            /* signal delivered, sleep on to the same rollover */
+        }
+        wokeNs = nowNs();
+        lateNs = 0U;
+        if(wokeNs > dueNs){
+            lateNs = wokeNs - dueNs;
+        }
+        if(lateNs > 0xFFFFFFFFULL){
+            lateNs = 0xFFFFFFFFULL;         /* seconds late, the u32 fields saturate */
+        }
+
+        run = (bool)(0UL != (HAL_REGS->TimerCtrl & HAL_TIMER_RUN));
+        handlerNs = 0U;
+        called = False;
+        if(True == run){
+            HAL_REGS->TimerTicks++;
+            HAL_REGS->TimerFlag = 1UL;      /* rollover interrupt pending */
+
+            pthread_mutex_lock(&isrLock);
+            if((0UL != (HAL_REGS->TimerCtrl & HAL_TIMER_IRUPT_EN)) && (0 != HalPeriodicHandler)){
+                HalPeriodicHandler();
+                handlerNs = nowNs() - wokeNs;
+                called = True;
+            }
+            pthread_mutex_unlock(&isrLock);
+        }
+        doneNs = nowNs();
+
+        /* next rollover; the ones already past are lost */
+        dueNs += periodNs;
+        lost = 0U;
+        if(doneNs >= dueNs){
+            lost = (doneNs - dueNs) / periodNs + 1U;
+            dueNs += lost * periodNs;
+        }
+
+        if(True == run){
+            HAL_REGS->TimerTicks += (u32)lost;
+
+            SyncStoreRelaxed(&statsSeq, statsSeq + 1U);
+            SyncFenceRelease();             /* odd sequence is visible before the data changes */
+            statsBuf.Ticks += 1U + lost;
+            statsBuf.Overruns += lost;
+            statsBuf.LateSumNs += lateNs;
+            if(lateNs > statsBuf.LateMaxNs){
+                statsBuf.LateMaxNs = (u32)lateNs;
+            }
+            if(True == called){
+                statsBuf.Calls++;
+                if(handlerNs > statsBuf.HandlerMaxNs){
+                    statsBuf.HandlerMaxNs = (u32)handlerNs;
+                }
+            }
+            bucket = 0U;
+            while((bucket < (PERIODIC_THREAD_BUCKETS - 1U)) && ((lateNs >> (bucket + 1U)) != 0U)){
+                bucket++;
+            }
+            statsBuf.LateHist[bucket]++;
+            SyncStore(&statsSeq, statsSeq + 1U);
+        }
+        /*ELSE: Do nothing, stopped channels are not timed*/
+    }
+    return 0;
+}
+
+static u64 nowNs(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
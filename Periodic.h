@@ -26,6 +26,13 @@ typedef void	(*PeriodicHandlerT)(void);
 //	macros
 /******************************************************************************/
 
+//	PERIODIC_ROLLOVERS: the backend provides PeriodicRollovers. Define it for
+//	a target timer driver that counts every rollover, including those that
+//	pass while the handler still runs or its flag is pending (e.g. an
+//	update interrupt count kept by the timer hardware or a higher priority
+//	interrupt). Without it overruns go undetected and the driver steps on
+//	every handler call. The inline HAL always provides it
+
 /******************************************************************************/
 //	service functions
 /******************************************************************************/
@@ -39,6 +46,25 @@ typedef void	(*PeriodicHandlerT)(void);
 */
 #define	PeriodicFreqHzMax	((f32)1000000)
 
+#ifdef	HAL_INLINE
+/******************************************************************************/
+//	header-inline HAL, every call compiles to a store into the timer registers
+#include	"HalRegs.h"
+
+#ifndef	PERIODIC_ROLLOVERS
+#define	PERIODIC_ROLLOVERS
+#endif
+
+static	inline	void	PeriodicConfig			(f32 FreqHz, PeriodicHandlerT Handler)	{	HalPeriodicConfig(FreqHz, Handler);	}
+static	inline	void	PeriodicStart			(void)	{	HalPeriodicStart();	}
+static	inline	void	PeriodicStop			(void)	{	HalPeriodicStop();	}
+static	inline	void	PeriodicIruptEnable		(void)	{	HalPeriodicIruptEnable();	}
+static	inline	void	PeriodicIruptDisable	(void)	{	HalPeriodicIruptDisable();	}
+static	inline	void	PeriodicIruptFlagClear	(void)	{	HalPeriodicIruptFlagClear();	}
+static	inline	u32		PeriodicRollovers		(void)	{	return	HalPeriodicRollovers();	}
+static	inline	void	PeriodicModuleInit		(void)	{	HalPeriodicModuleInit();	}
+
+#else
 //	set the rollover frequency and assign an interrupt handler
 void	PeriodicConfig			(f32	FreqHz, PeriodicHandlerT Handler);
 
@@ -62,6 +88,17 @@ void	PeriodicIruptDisable	(void);
 //	dismiss the channel's rollover interrupt flag
 void	PeriodicIruptFlagClear	(void);
 
+#ifdef	PERIODIC_ROLLOVERS
+/******************************************************************************/
+//	rollovers since PeriodicModuleInit
+/*
+	- counts on while the handler runs late; a handler finding it advanced by
+	  more than one since its last call overran its period
+	- only with PERIODIC_ROLLOVERS, see above
+*/
+u32		PeriodicRollovers		(void);
+#endif
+
 /******************************************************************************/
 //	administrative functions
 /******************************************************************************/
@@ -70,6 +107,8 @@ void	PeriodicIruptFlagClear	(void);
 //	initialize the overall module, call before using any of the above functions
 void	PeriodicModuleInit	(void);
 
+#endif	//	HAL_INLINE
+
 /******************************************************************************/
 #endif  //  PeriodicIncluded
 /******************************************************************************/
@@ -0,0 +1,51 @@
+/******************************************************************************/
+//	PeriodicSim.h
+/******************************************************************************/
+#ifndef	PeriodicSimIncluded
+#define PeriodicSimIncluded
+/******************************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+
+#include	"Generic.h"
+
+/******************************************************************************/
+//	service functions
+/*
+	- host only, provided by the register level backends (REGS, INLINE, REGFILE)
+*/
+/******************************************************************************/
+
+/******************************************************************************/
+//	advance the simulated timer by Ticks rollovers
+/*
+	- while the channel is started every rollover counts in TimerTicks, sets the
+	  interrupt flag and, with the interrupt enabled, calls the handler
+*/
+void	PeriodicSimRun	(u32 Ticks);
+
+/******************************************************************************/
+//	let Ticks rollovers pass without a handler call, as after a handler that
+//	overran its period
+/*
+	- they count in TimerTicks while the channel is started, the flag they
+	  set was dismissed by the late handler
+*/
+void	PeriodicSimOverrun	(u32 Ticks);
+
+/******************************************************************************/
+//	call Watch after every pad write, 0 for none
+/*
+	- out-of-line pin backend only (REGS, REGFILE): lets a host check see the
+	  order of the writes within a tick, which sampling the port after each
+	  handler call cannot
+*/
+void	PinSimWatch		(void (*Watch)(void));
+
+/******************************************************************************/
+#endif  //  PeriodicSimIncluded
+/******************************************************************************/
+//  end of PeriodicSim.h
+/******************************************************************************/
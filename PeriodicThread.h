@@ -0,0 +1,67 @@
+/******************************************************************************/
+//	PeriodicThread.h
+/******************************************************************************/
+#ifndef	PeriodicThreadIncluded
+#define PeriodicThreadIncluded
+/******************************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+
+#include	"Generic.h"
+
+/******************************************************************************/
+//	macros
+/******************************************************************************/
+
+//	lateness histogram, bucket b: [2^b, 2^(b+1)) ns, the last one open
+#define	PERIODIC_THREAD_BUCKETS		24U
+
+/******************************************************************************/
+//	types
+/******************************************************************************/
+
+//	timing of the timer thread since PeriodicConfig
+typedef	struct
+{	u64		Ticks;				//	rollovers while started, lost ones included
+	u64		Calls;				//	handler calls
+	u64		Overruns;			//	rollovers lost, the thread woke or finished too late
+	u64		LateSumNs;			//	wake-up lateness summed over the started rollovers
+	u32		LateMaxNs;			//	worst wake-up lateness
+	u32		HandlerMaxNs;		//	longest handler call
+	u32		LateHist[PERIODIC_THREAD_BUCKETS];	//	wake-ups by lateness
+	bool	RealTime;			//	running with the SCHED_FIFO priority asked for
+}	PeriodicThreadStatsT;
+
+/******************************************************************************/
+//	service functions
+/*
+	- host only, provided by the threaded backend (HalThread.c, HAL_THREAD)
+	- the handler runs on a dedicated POSIX thread woken at every rollover
+	  by clock_nanosleep on CLOCK_MONOTONIC, concurrently with the caller
+*/
+/******************************************************************************/
+
+/******************************************************************************/
+//	place the timer thread, call before PeriodicConfig
+/*
+	- Cpu: core to pin the thread to, negative for any
+	- Priority: SCHED_FIFO priority, 0 for the default policy; without the
+	  privilege the thread runs at the default policy and RealTime is False
+*/
+void	PeriodicThreadPlace		(s32 Cpu, s32 Priority);
+
+/******************************************************************************/
+//	snapshot of the timer thread timing, consistent across all fields
+void	PeriodicThreadStats		(PeriodicThreadStatsT *Stats);
+
+/******************************************************************************/
+//	stop and join the timer thread, PeriodicConfig starts a new one
+void	PeriodicThreadExit		(void);
+
+/******************************************************************************/
+#endif  //  PeriodicThreadIncluded
+/******************************************************************************/
+//  end of PeriodicThread.h
+/******************************************************************************/
@@ -0,0 +1,285 @@
+/*H**********************************************************************
+* FILENAME : Pin.c
+* DESCRIPTION : Shadow register layer between PinWrite and the pin backend
+* PUBLIC FUNCTIONS :
+*           void PinWrite(PinT Pin, bool Value)
+*           void PinWriteMask(u32 Mask, u32 Value)
+*           void PinFlush(void)
+*           void PinModuleInit(void)
+*           void PinShadowModeSet(PinShadowModeT Mode)
+*           void PinStatsGet(PinStatsT *Stats)
+*           void PinStatsClear(void)
+* NOTES : Keeps the last value driven on every PinT and drops writes
+*         that would not change the pad. In deferred mode writes are
+*         queued in the order they were issued and PinFlush issues them
+*         once per tick in that order, so a device rule such as "CS
+*         rises only with INC high" holds as the caller wrote it.
+*         PinWriteMask writes the pads it changes with one port access,
+*         also when deferred.
+*         State is kept one byte per pin so that a write from the
+*         application and one from the ISR never share a read-modify-write.
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   Shadow register write cache
+* 0.1.1   18Oct2026   agent   Thread local shadow registers
+* 0.2.0   18Oct2026   agent   Several pins in one port write
+* 0.2.1   18Oct2026   agent   Deferred writes flushed in issue order, a
+*                             mask write kept as one port write
+*H***********************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include "Pin.h"
+#include "Sync.h"
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+#define PIN_UNKNOWN 0xFFU               /* pad value not known to the shadow register */
+#define PIN_PEND_QUAN (4U * (u8)PinQuan) /* writes queued per flush, a full queue flushes early */
+
+static SyncLocal PinShadowModeT shadowMode = PIN_SHADOW_DEFAULT; /* active shadow mode */
+static SyncLocal u8 padVal[PinQuan];    /* value last written to the pad */
+static SyncLocal u32 pendMask[PIN_PEND_QUAN];   /* queued writes in issue order (deferred mode) */
+static SyncLocal u32 pendValue[PIN_PEND_QUAN];
+static SyncLocal u8 pendQuan;           /* writes queued */
+static SyncLocal PinStatsT pinStats;    /* shadow register statistics */
+
+/******************************************************************************
+ *	local functions
+ ******************************************************************************/
+static void padWrite(PinT Pin, bool Value);
+static void padWriteMask(u32 Mask, u32 Value);
+static void pendAdd(u32 Mask, u32 Value);
+static void shadowInvalidate(void);
+
+/********************************************************************
+* FUNCTION   : void PinWrite(PinT Pin, bool Value)
+* PURPOSE    : Write a pin through the shadow register
+* PARAMETERS : PinT Pin             //pin to write
+*              bool Value           //value to drive
+* RETURN     : void
+**********************************************************************/
+void PinWrite(PinT Pin, bool Value){
+
+    Value = (bool)(False != Value);         /* normalize to 0/1 for comparison */
+    pinStats.Requests++;
+
+    switch(shadowMode){
+        case PinShadowWriteThrough:
+            if(Value != padVal[Pin]){
+                padWrite(Pin, Value);
+            }else{
+                pinStats.Saved++;           /* pad already holds the value */
+            }
+            break;
+
+        case PinShadowDeferred:
+            pendAdd(1UL << Pin, (u32)Value << Pin);
+            break;
+
+        default:
+            padWrite(Pin, Value);
+            break;
+    }
+}
+
+/********************************************************************
+* FUNCTION   : void PinWriteMask(u32 Mask, u32 Value)
+* PURPOSE    : Write several pins through the shadow register
+* PARAMETERS : u32 Mask             //bit n selects PinT n
+*              u32 Value            //bit n is the value to drive on PinT n
+* RETURN     : void
+* NOTE       : one backend call for all pads that change, counted as one
+*              bus write
+**********************************************************************/
+void PinWriteMask(u32 Mask, u32 Value){
+    u8 pin;
+
+    for(pin = 0U; pin < (u8)PinQuan; pin++){
+        if(0UL != (Mask & (1UL << pin))){
+            pinStats.Requests++;
+        }/*ELSE: Do nothing*/
+    }
+
+    switch(shadowMode){
+        case PinShadowWriteThrough:
+            padWriteMask(Mask, Value);
+            break;
+
+        case PinShadowDeferred:
+            pendAdd(Mask, Value);
+            break;
+
+        default:
+            if(0UL != Mask){
+                PinPadWriteMask(Mask, Value);
+                for(pin = 0U; pin < (u8)PinQuan; pin++){
+                    if(0UL != (Mask & (1UL << pin))){
+                        padVal[pin] = (u8)((Value >> pin) & 1UL);
+                    }/*ELSE: Do nothing*/
+                }
+                pinStats.BusWrites++;
+            }/*ELSE: Do nothing*/
+            break;
+    }
+}
+
+/********************************************************************
+* FUNCTION   : void PinFlush(void)
+* PURPOSE    : Issue writes queued in deferred mode
+* PARAMETERS : void
+* RETURN     : void
+* NOTE       : in issue order; a queued write of the value a pad holds at
+*              that point is dropped, a mask write goes out as one
+*              port write
+**********************************************************************/
+void PinFlush(void){
+    u8 quan = pendQuan;
+    u8 i;
+
+    pendQuan = 0U;
+    for(i = 0U; i < quan; i++){
+        padWriteMask(pendMask[i], pendValue[i]);
+    }
+}
+
+/********************************************************************
+* FUNCTION   : void PinModuleInit(void)
+* PURPOSE    : Initialize pin module and shadow register
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+void PinModuleInit(void){
+
+    PinPadModuleInit();                     /* Initialize pin backend */
+    shadowInvalidate();
+}
+
+/********************************************************************
+* FUNCTION   : void PinShadowModeSet(PinShadowModeT Mode)
+* PURPOSE    : Select shadow register mode
+* PARAMETERS : PinShadowModeT Mode  //new shadow mode
+* RETURN     : void
+**********************************************************************/
+void PinShadowModeSet(PinShadowModeT Mode){
+
+    PinFlush();                             /* do not lose writes pending in deferred mode */
+    shadowMode = Mode;
+}
+
+/********************************************************************
+* FUNCTION   : void PinStatsGet(PinStatsT *Stats)
+* PURPOSE    : Read shadow register statistics
+* PARAMETERS : PinStatsT *Stats     //destination of the statistics
+* RETURN     : void
+**********************************************************************/
+void PinStatsGet(PinStatsT *Stats){
+
+    if(0 != Stats){
+        *Stats = pinStats;
+    }
+}
+
+/********************************************************************
+* FUNCTION   : void PinStatsClear(void)
+* PURPOSE    : Reset shadow register statistics
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+void PinStatsClear(void){
+
+    pinStats.Requests = 0U;
+    pinStats.BusWrites = 0U;
+    pinStats.Saved = 0U;
+}
+
+/********************************************************************
+* FUNCTION   : static void padWrite(PinT Pin, bool Value)
+* PURPOSE    : Write the pad and record the value in the shadow register
+* PARAMETERS : PinT Pin             //pin to write
+*              bool Value           //value to drive
+* RETURN     : void
+**********************************************************************/
+static void padWrite(PinT Pin, bool Value){
+
+    PinPadWrite(Pin, Value);
+    padVal[Pin] = Value;
+    pinStats.BusWrites++;
+}
+
+/********************************************************************
+* FUNCTION   : static void padWriteMask(u32 Mask, u32 Value)
+* PURPOSE    : Write the pads of Mask that change, with one port access
+* PARAMETERS : u32 Mask             //bit n selects PinT n
+*              u32 Value            //bit n is the value to drive on PinT n
+* RETURN     : void
+* NOTE       : a single changing pad goes through PinPadWrite
+**********************************************************************/
+static void padWriteMask(u32 Mask, u32 Value){
+    u32 write = 0UL;                        /* pads to write */
+    u8 quan = 0U;
+    u8 last = 0U;
+    u8 pin;
+
+    for(pin = 0U; pin < (u8)PinQuan; pin++){
+        if(0UL != (Mask & (1UL << pin))){
+            if((u8)((Value >> pin) & 1UL) != padVal[pin]){
+                write |= (1UL << pin);
+                quan++;
+                last = pin;
+            }else{
+                pinStats.Saved++;           /* pad already holds the value */
+            }
+        }/*ELSE: Do nothing*/
+    }
+
+    if(1U == quan){
+        padWrite((PinT)last, (bool)((Value >> last) & 1UL));
+    }else{
+        if(0U != quan){
+            PinPadWriteMask(write, Value);
+            for(pin = 0U; pin < (u8)PinQuan; pin++){
+                if(0UL != (write & (1UL << pin))){
+                    padVal[pin] = (u8)((Value >> pin) & 1UL);
+                }/*ELSE: Do nothing*/
+            }
+            pinStats.BusWrites++;
+        }/*ELSE: Do nothing*/
+    }
+}
+
+/********************************************************************
+* FUNCTION   : static void pendAdd(u32 Mask, u32 Value)
+* PURPOSE    : Queue a write for the next PinFlush
+* PARAMETERS : u32 Mask             //bit n selects PinT n
+*              u32 Value            //bit n is the value to drive on PinT n
+* RETURN     : void
+* NOTE       : a full queue is flushed first, which keeps the order
+**********************************************************************/
+static void pendAdd(u32 Mask, u32 Value){
+
+    if(PIN_PEND_QUAN == pendQuan){
+        PinFlush();
+    }/*ELSE: Do nothing*/
+    pendMask[pendQuan] = Mask;
+    pendValue[pendQuan] = Value;
+    pendQuan++;
+}
+
+/********************************************************************
+* FUNCTION   : static void shadowInvalidate(void)
+* PURPOSE    : Forget all pad values and pending writes
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+static void shadowInvalidate(void){
+    u8 pin;
+
+    for(pin = 0U; pin < (u8)PinQuan; pin++){
+        padVal[pin] = PIN_UNKNOWN;
+    }
+    pendQuan = 0U;
+}
@@ -25,6 +25,20 @@ typedef	enum
 ,	PinQuan //  quantity of supported pins
 }	PinT;
 
+//	shadow register modes
+typedef	enum
+{	PinShadowOff			//	every PinWrite goes to the pad
+,	PinShadowWriteThrough	//	writes of the value a pad already holds are dropped
+,	PinShadowDeferred		//	writes are queued and issued by PinFlush, in issue order
+}	PinShadowModeT;
+
+//	shadow register statistics
+typedef	struct
+{	u32	Requests;			//	PinWrite calls
+	u32	BusWrites;			//	writes issued to the pads
+	u32	Saved;				//	writes dropped as no-op or collapsed before a flush
+}	PinStatsT;
+
 /*******************************************************************************/
 //	variables
 /*******************************************************************************/
@@ -33,21 +47,84 @@ typedef	enum
 //	macros
 /*******************************************************************************/
 
+//	shadow mode in effect after PinModuleInit
+#ifndef	PIN_SHADOW_DEFAULT
+#define	PIN_SHADOW_DEFAULT	PinShadowWriteThrough
+#endif
+
 /*******************************************************************************/
 //	service functions
 /*******************************************************************************/
+#ifdef	HAL_INLINE
+/*******************************************************************************/
+//	header-inline HAL, PinWrite compiles to a store into the GPIO port register
+/*
+	- no shadow register, the port register already holds the pad state
+*/
+#include	"HalRegs.h"
 
+static	inline	void	PinWrite		(PinT Pin, bool Value)	{	HalPinWrite((u8)Pin, Value);	}
+static	inline	void	PinWriteMask	(u32 Mask, u32 Value)	{	HalPinWriteMask(Mask, Value);	}
+static	inline	void	PinFlush		(void)					{	}
+static	inline	void	PinModuleInit	(void)					{	HalPinModuleInit();	}
+
+#else
 /*******************************************************************************/
 //	write to a pad that is configured as a GPIO output
+/*
+	- the write is dropped if the shadow register shows the pad already holds Value
+	- in PinShadowDeferred mode the pad is only written by the next PinFlush
+*/
 void	PinWrite		(PinT Pin, bool Value);
+
+/*******************************************************************************/
+//	write several pads with one port access
+/*
+	- bit n of Mask selects PinT n, bit n of Value is the value to drive on it
+	- pads the shadow register shows at their value are left out, as by PinWrite
+	- in PinShadowDeferred mode the write is queued like one of PinWrite and
+	  still goes out as one port access
+*/
+void	PinWriteMask	(u32 Mask, u32 Value);
+
+/*******************************************************************************/
+//	issue all writes queued since the last flush (PinShadowDeferred mode)
+/*
+	- call once per tick; returns immediately in the other modes
+	- writes go out in the order they were issued, so the pad sequence within
+	  a tick is the one the caller wrote
+*/
+void	PinFlush		(void);
+
 /******************************************************************************/
 //	administrative functions
 /******************************************************************************/
 //void Timer_ISR(void);
 /******************************************************************************/
 //	initialize the overall module (call before using any of the above functions)
+/*
+	- the shadow register is invalidated, the first write to each pad always goes through
+*/
 void	PinModuleInit	(void);
 
+/******************************************************************************/
+//	select the shadow register mode, pending writes are flushed first
+void	PinShadowModeSet	(PinShadowModeT Mode);
+
+/******************************************************************************/
+//	read and reset the shadow register statistics
+void	PinStatsGet		(PinStatsT *Stats);
+void	PinStatsClear	(void);
+
+/******************************************************************************/
+//	pad access, provided by the pin backend and used by the shadow layer only
+/******************************************************************************/
+void	PinPadWrite		(PinT Pin, bool Value);
+void	PinPadWriteMask	(u32 Mask, u32 Value);
+void	PinPadModuleInit	(void);
+
+#endif	//	HAL_INLINE
+
 /*******************************************************************************/
 #endif  //  PinIncluded
 /*******************************************************************************/
@@ -0,0 +1,38 @@
+/******************************************************************************/
+//	Spi.h
+/******************************************************************************/
+#ifndef	SpiIncluded
+#define SpiIncluded
+/******************************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+
+#include	"Generic.h"
+
+/******************************************************************************/
+//	service functions
+/******************************************************************************/
+
+/******************************************************************************/
+//	full duplex transfer of Len bytes as one transaction
+/*
+	- chip select is asserted for the whole transfer
+	- Rx may be null if the received bytes are not needed
+*/
+void	SpiTransfer		(const u8 *Tx, u8 *Rx, u8 Len);
+
+/******************************************************************************/
+//	administrative functions
+/******************************************************************************/
+
+/******************************************************************************/
+//	initialize the overall module, call before using any of the above functions
+void	SpiModuleInit	(void);
+
+/******************************************************************************/
+#endif  //  SpiIncluded
+/******************************************************************************/
+//  end of Spi.h
+/******************************************************************************/
@@ -0,0 +1,98 @@
+/*H**********************************************************************
+* FILENAME : SpiSim.c
+* DESCRIPTION : Simulated SPI bus with an SPI programmed dual potentiometer
+* PUBLIC FUNCTIONS :
+*           void SpiModuleInit(void)
+*           void SpiTransfer(const u8 *Tx, u8 *Rx, u8 Len)
+*           u16 SpiSimWiper(u8 Wiper)
+*           u32 SpiSimTransfers(void)
+* NOTES : Decodes 16 bit write commands (see SpiSim.h) into two wiper
+*         registers. Anything else is ignored, like the part would.
+* AUTHOR : agent         DATE : 18 Oct 2026
+* CHANGES :
+* VERSION   DATE      WHO     DETAIL
+* 0.1.0   18Oct2026   agent   Simulated SPI bus and potentiometer
+* 0.1.1   18Oct2026   agent   Thread local bus state
+*H***********************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+#include "Spi.h"
+#include "SpiSim.h"
+#include "Sync.h"
+
+/******************************************************************************
+ *	variables
+ ******************************************************************************/
+static SyncLocal u16 wiper[SPI_POT_WIPERS]; /* wiper registers of the simulated part */
+static SyncLocal u32 transfers;             /* transactions since init */
+
+/********************************************************************
+* FUNCTION   : void SpiModuleInit(void)
+* PURPOSE    : Initialize the bus, power-on reset the potentiometer
+* PARAMETERS : void
+* RETURN     : void
+**********************************************************************/
+void SpiModuleInit(void){
+    u8 idx;
+
+    for(idx = 0U; idx < SPI_POT_WIPERS; idx++){
+        wiper[idx] = SPI_POT_POR_TAP;
+    }
+    transfers = 0U;
+}
+
+/********************************************************************
+* FUNCTION   : void SpiTransfer(const u8 *Tx, u8 *Rx, u8 Len)
+* PURPOSE    : One transaction on the simulated bus
+* PARAMETERS : const u8 *Tx         //bytes sent
+*              u8 *Rx               //bytes received, may be null
+*              u8 Len               //transfer length
+* RETURN     : void
+**********************************************************************/
+void SpiTransfer(const u8 *Tx, u8 *Rx, u8 Len){
+    u8 addr;
+    u8 cmd;
+    u8 idx;
+
+    transfers++;
+
+    /* the part answers with all ones while it decodes a write */
+    if(0 != Rx){
+        for(idx = 0U; idx < Len; idx++){
+            Rx[idx] = 0xFFU;
+        }
+    }
+
+    if(2U == Len){
+        addr = (u8)(Tx[0] >> 4);
+        cmd = (u8)((Tx[0] >> 2) & 0x3U);
+
+        if((SPI_POT_CMD_WRITE == cmd) && (addr < SPI_POT_WIPERS)){
+            wiper[addr] = (u16)(((u16)(Tx[0] & 0x3U) << 8) | Tx[1]);
+        }
+    }
+}
+
+/********************************************************************
+* FUNCTION   : u16 SpiSimWiper(u8 Wiper)
+* PURPOSE    : Read back a wiper of the simulated potentiometer
+* PARAMETERS : u8 Wiper             //wiper index
+* RETURN     : u16
+**********************************************************************/
+u16 SpiSimWiper(u8 Wiper){
+
+    return (Wiper < SPI_POT_WIPERS) ? wiper[Wiper] : 0U;
+}
+
+/********************************************************************
+* FUNCTION   : u32 SpiSimTransfers(void)
+* PURPOSE    : Transactions seen since SpiModuleInit
+* PARAMETERS : void
+* RETURN     : u32
+**********************************************************************/
+u32 SpiSimTransfers(void){
+
+    return transfers;
+}
@@ -0,0 +1,45 @@
+/******************************************************************************/
+//	SpiSim.h
+/******************************************************************************/
+#ifndef	SpiSimIncluded
+#define SpiSimIncluded
+/******************************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+
+#include	"Generic.h"
+
+/******************************************************************************/
+//	macros
+/******************************************************************************/
+
+//	command frame of the simulated SPI potentiometer (MCP42x1 style)
+/*
+	- byte 0: address[7:4] command[3:2] data[9:8], byte 1: data[7:0]
+*/
+#define	SPI_POT_ADDR_WIPER0	0x0U
+#define	SPI_POT_ADDR_WIPER1	0x1U
+#define	SPI_POT_CMD_WRITE	0x0U
+#define	SPI_POT_WIPERS		2U
+#define	SPI_POT_POR_TAP		128U	//	wiper position after power-on
+
+/******************************************************************************/
+//	service functions
+/*
+	- host only, inspect the potentiometer behind the simulated bus
+*/
+/******************************************************************************/
+
+//	current wiper position
+u16		SpiSimWiper		(u8 Wiper);
+
+//	transactions seen since SpiModuleInit
+u32		SpiSimTransfers	(void);
+
+/******************************************************************************/
+#endif  //  SpiSimIncluded
+/******************************************************************************/
+//  end of SpiSim.h
+/******************************************************************************/
@@ -0,0 +1,61 @@
+/******************************************************************************/
+//	Sync.h
+/******************************************************************************/
+#ifndef	SyncIncluded
+#define SyncIncluded
+/******************************************************************************/
+
+/******************************************************************************/
+//	includes
+/******************************************************************************/
+
+#include	"Generic.h"
+
+/******************************************************************************/
+//	macros
+/*
+	- ordering primitives for data shared between the ISR (or the emulated
+	  ISR thread on the host) and the application, without masking interrupts
+	- GCC/Clang builtins, available on the host and the ARM toolchains
+*/
+/******************************************************************************/
+
+//	load of a shared word, later accesses are not hoisted above it
+#define	SyncLoad(Ptr)			__atomic_load_n((Ptr), __ATOMIC_ACQUIRE)
+
+//	store of a shared word, earlier accesses are not sunk below it
+#define	SyncStore(Ptr, Val)		__atomic_store_n((Ptr), (Val), __ATOMIC_RELEASE)
+
+//	load/store of a shared word without ordering
+#define	SyncLoadRelaxed(Ptr)		__atomic_load_n((Ptr), __ATOMIC_RELAXED)
+#define	SyncStoreRelaxed(Ptr, Val)	__atomic_store_n((Ptr), (Val), __ATOMIC_RELAXED)
+
+//	fences
+#define	SyncFenceAcquire()		__atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define	SyncFenceRelease()		__atomic_thread_fence(__ATOMIC_RELEASE)
+
+//	full fence: a store before it is seen before a load after it is made,
+//	on both sides (one flag each, as in Dekker's algorithm). An ISR on the
+//	core it interrupts needs only the compiler to keep the order; the
+//	emulated ISR thread (HAL_THREAD) runs on another core
+#ifdef	HAL_THREAD
+#define	SyncFenceFull()			__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define	SyncFenceFull()			__atomic_signal_fence(__ATOMIC_SEQ_CST)
+#endif
+
+//	storage class of module state; with HAL_THREAD_LOCAL (host only) every
+//	thread owns a copy, so each thread runs an independent driver and HAL
+#if		defined(HAL_THREAD_LOCAL) && defined(__cplusplus)
+#define	SyncLocal			thread_local
+#elif	defined(HAL_THREAD_LOCAL)
+#define	SyncLocal			_Thread_local
+#else
+#define	SyncLocal
+#endif
+
+/******************************************************************************/
+#endif  //  SyncIncluded
+/******************************************************************************/
+//  end of Sync.h
+/******************************************************************************/
@@ -30,9 +30,12 @@ void	PeriodicIruptFlagClear	(void){
 
 
 
-void    PinModuleInit   (void){
+void    PinPadModuleInit   (void){
     printf("PinModuleInit Called!\n");
 }
-void	PinWrite		(PinT Pin, bool Value){
+void	PinPadWrite		(PinT Pin, bool Value){
     printf("Pin number is: %d, Written with value: %d\n", Pin, Value);
+}
+void	PinPadWriteMask	(u32 Mask, u32 Value){
+    printf("Pin mask is: 0x%02X, Written with value: 0x%02X\n", Mask, Value & Mask);
 }
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include <stdio.h>
 #include "DualPot_Drv.h"
+#ifdef HAL_SIM
+#include "PeriodicSim.h"
+#define SIM_TICKS_PER_CALL 2U   /* simulated timer rollovers between two calls */
+#endif
 
 int main() {
     bool result = False;
@@ -14,6 +18,9 @@ int main() {
     {
         printf("\nDual digi driver main function is called %d!\n", counter);
         //ISR_Timer25us_Handler();  /* for testing purpose */
+#ifdef HAL_SIM
+        PeriodicSimRun(SIM_TICKS_PER_CALL);
+#endif
 
         result = DualPotDrv_Main(1, 6000);
         result1 = DualPotDrv_Main(2, 4000);